@@ -0,0 +1,119 @@
+#include "pci_caps.h"
+
+//          
+#define PCI_CAP_MAX_STANDARD  48
+#define PCI_CAP_MAX_EXTENDED  ((PCI_CFG_EXT_SPACE_SIZE - PCI_CFG_EXT_CAP_START) / 8)
+
+static uint32_t PciCapRead32(const PCI_CAP_SOURCE* source, uint16_t offset) {
+    return source->Read(source->Context, (uint16_t)(offset & ~3u));
+}
+
+static uint16_t PciCapRead16(const PCI_CAP_SOURCE* source, uint16_t offset) {
+    return (uint16_t)(PciCapRead32(source, offset) >> ((offset & 2) * 8));
+}
+
+static uint8_t PciCapRead8(const PCI_CAP_SOURCE* source, uint16_t offset) {
+    return (uint8_t)(PciCapRead32(source, offset) >> ((offset & 3) * 8));
+}
+
+int PciCapFirst(const PCI_CAP_SOURCE* source, PCI_CAP_CURSOR* cursor, PCI_CAPABILITY* capability) {
+    uint16_t status = PciCapRead16(source, PCI_CFG_STATUS);
+    uint8_t headerType = PCI_HEADER_TYPE(PciCapRead32(source, PCI_CFG_HEADER)) & PCI_HEADER_TYPE_MASK;
+
+    cursor->Extended = 0;
+    cursor->Remaining = PCI_CAP_MAX_STANDARD;
+    cursor->Next = 0;
+
+    if (status != 0xFFFF && (status & PCI_STATUS_CAP_LIST)) {
+        uint16_t pointer = (headerType == PCI_HEADER_TYPE_CARDBUS) ? PCI_CFG_CARDBUS_CAP_PTR : PCI_CFG_CAP_PTR;
+        cursor->Next = PciCapRead8(source, pointer) & 0xFC;
+    }
+
+    return PciCapNext(source, cursor, capability);
+}
+
+//      0x34,    0x100
+int PciCapNext(const PCI_CAP_SOURCE* source, PCI_CAP_CURSOR* cursor, PCI_CAPABILITY* capability) {
+    uint32_t header;
+
+    if (!cursor->Extended) {
+        if (cursor->Next >= PCI_CFG_HEADER_SIZE && cursor->Remaining > 0 &&
+            cursor->Next + 4u <= source->ConfigSize) {
+            header = PciCapRead32(source, cursor->Next);
+
+            capability->Offset = cursor->Next;
+            capability->Id = (uint16_t)(header & 0xFF);
+            capability->Version = 0;
+            capability->Extended = 0;
+
+            cursor->Next = (uint16_t)((header >> 8) & 0xFC);
+            cursor->Remaining--;
+            return 1;
+        }
+
+        if (source->ConfigSize <= PCI_CFG_SPACE_SIZE) {
+            return 0;
+        }
+
+        cursor->Extended = 1;
+        cursor->Next = PCI_CFG_EXT_CAP_START;
+        cursor->Remaining = PCI_CAP_MAX_EXTENDED;
+    }
+
+    if (cursor->Next < PCI_CFG_EXT_CAP_START || cursor->Remaining == 0 ||
+        cursor->Next + 4u > source->ConfigSize) {
+        return 0;
+    }
+
+    header = PciCapRead32(source, cursor->Next);
+    if (header == 0 || header == 0xFFFFFFFF) {
+        cursor->Next = 0;
+        return 0;
+    }
+
+    capability->Offset = cursor->Next;
+    capability->Id = PCI_EXT_CAP_ID(header);
+    capability->Version = PCI_EXT_CAP_VER(header);
+    capability->Extended = 1;
+
+    cursor->Next = PCI_EXT_CAP_NEXT(header);
+    cursor->Remaining--;
+    return 1;
+}
+
+uint16_t PciCapFind(const PCI_CAP_SOURCE* source, uint8_t id) {
+    PCI_CAP_CURSOR cursor;
+    PCI_CAPABILITY capability;
+    int found;
+
+    for (found = PciCapFirst(source, &cursor, &capability); found && !capability.Extended;
+        found = PciCapNext(source, &cursor, &capability)) {
+        if (capability.Id == id) {
+            return capability.Offset;
+        }
+    }
+
+    return 0;
+}
+
+uint16_t PciExtCapFind(const PCI_CAP_SOURCE* source, uint16_t id) {
+    PCI_CAP_CURSOR cursor;
+    PCI_CAPABILITY capability;
+
+    if (source->ConfigSize <= PCI_CFG_SPACE_SIZE) {
+        return 0;
+    }
+
+    //      ,   
+    cursor.Extended = 1;
+    cursor.Next = PCI_CFG_EXT_CAP_START;
+    cursor.Remaining = PCI_CAP_MAX_EXTENDED;
+
+    while (PciCapNext(source, &cursor, &capability)) {
+        if (capability.Id == id) {
+            return capability.Offset;
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
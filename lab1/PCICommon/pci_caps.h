@@ -0,0 +1,36 @@
+#pragma once
+#include "pci_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t (*PCI_CAP_READ)(void* context, uint16_t offset);
+
+typedef struct _PCI_CAP_SOURCE {
+    PCI_CAP_READ Read;
+    void* Context;
+    uint16_t ConfigSize;
+} PCI_CAP_SOURCE, * PPCI_CAP_SOURCE;
+
+typedef struct _PCI_CAPABILITY {
+    uint16_t Offset;
+    uint16_t Id;
+    uint8_t Version;
+    uint8_t Extended;
+} PCI_CAPABILITY, * PPCI_CAPABILITY;
+
+typedef struct _PCI_CAP_CURSOR {
+    uint16_t Next;
+    uint16_t Remaining;
+    uint8_t Extended;
+} PCI_CAP_CURSOR, * PPCI_CAP_CURSOR;
+
+int PciCapFirst(const PCI_CAP_SOURCE* source, PCI_CAP_CURSOR* cursor, PCI_CAPABILITY* capability);
+int PciCapNext(const PCI_CAP_SOURCE* source, PCI_CAP_CURSOR* cursor, PCI_CAPABILITY* capability);
+uint16_t PciCapFind(const PCI_CAP_SOURCE* source, uint8_t id);
+uint16_t PciExtCapFind(const PCI_CAP_SOURCE* source, uint16_t id);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
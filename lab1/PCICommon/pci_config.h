@@ -0,0 +1,147 @@
+#pragma once
+#include <stdint.h>
+
+#define PCI_MAX_BUSES      256
+#define PCI_MAX_DEVICES    32
+#define PCI_MAX_FUNCTIONS  8
+
+#define PCI_CFG_HEADER_SIZE     64
+#define PCI_CFG_HEADER_DWORDS   (PCI_CFG_HEADER_SIZE / 4)
+#define PCI_CFG_SPACE_SIZE      256
+#define PCI_CFG_EXT_SPACE_SIZE  4096
+
+#define PCI_CFG_ID                0x00
+#define PCI_CFG_COMMAND           0x04
+#define PCI_CFG_STATUS            0x06
+#define PCI_CFG_CLASS_REV         0x08
+#define PCI_CFG_HEADER            0x0C
+#define PCI_CFG_BAR0              0x10
+#define PCI_CFG_CARDBUS_CAP_PTR   0x14
+#define PCI_CFG_BUS_NUMBERS       0x18
+#define PCI_CFG_SUBSYSTEM         0x2C
+#define PCI_CFG_CAP_PTR           0x34
+#define PCI_CFG_EXT_CAP_START     0x100
+
+#define PCI_STATUS_CAP_LIST       0x0010
+
+#define PCI_BAR_COUNT_NORMAL       6
+#define PCI_BAR_COUNT_BRIDGE       2
+#define PCI_BAR_SPACE_IO           0x01
+#define PCI_BAR_MEM_TYPE_MASK      0x06
+#define PCI_BAR_MEM_TYPE_64        0x04
+#define PCI_BAR_MEM_PREFETCH       0x08
+#define PCI_BAR_IO_ADDR_MASK       0xFFFFFFFCu
+#define PCI_BAR_MEM_ADDR_MASK      0xFFFFFFF0u
+
+#define PCI_HEADER_TYPE_MASK       0x7F
+#define PCI_HEADER_MULTIFUNCTION   0x80
+#define PCI_HEADER_TYPE_NORMAL     0x00
+#define PCI_HEADER_TYPE_BRIDGE     0x01
+#define PCI_HEADER_TYPE_CARDBUS    0x02
+
+#define PCI_INVALID_VENDOR_ID  0xFFFF
+
+#define PCI_ID_VENDOR(id)         ((uint16_t)((id) & 0xFFFF))
+#define PCI_ID_DEVICE(id)         ((uint16_t)(((id) >> 16) & 0xFFFF))
+#define PCI_CLASS_REVISION(cr)    ((uint8_t)((cr) & 0xFF))
+#define PCI_CLASS_PROG_IF(cr)     ((uint8_t)(((cr) >> 8) & 0xFF))
+#define PCI_CLASS_SUB(cr)         ((uint8_t)(((cr) >> 16) & 0xFF))
+#define PCI_CLASS_BASE(cr)        ((uint8_t)(((cr) >> 24) & 0xFF))
+#define PCI_HEADER_TYPE(hdr)      ((uint8_t)(((hdr) >> 16) & 0xFF))
+#define PCI_BUS_PRIMARY(bn)       ((uint8_t)((bn) & 0xFF))
+#define PCI_BUS_SECONDARY(bn)     ((uint8_t)(((bn) >> 8) & 0xFF))
+#define PCI_BUS_SUBORDINATE(bn)   ((uint8_t)(((bn) >> 16) & 0xFF))
+#define PCI_CAP_ID_PM         0x01
+#define PCI_CAP_ID_AGP        0x02
+#define PCI_CAP_ID_VPD        0x03
+#define PCI_CAP_ID_SLOTID     0x04
+#define PCI_CAP_ID_MSI        0x05
+#define PCI_CAP_ID_HT         0x08
+#define PCI_CAP_ID_VNDR       0x09
+#define PCI_CAP_ID_DBG        0x0A
+#define PCI_CAP_ID_SSVID      0x0D
+#define PCI_CAP_ID_EXP        0x10
+#define PCI_CAP_ID_MSIX       0x11
+#define PCI_CAP_ID_SATA       0x12
+#define PCI_CAP_ID_AF         0x13
+#define PCI_CAP_ID_EA         0x14
+
+#define PCI_EXT_CAP_ID_AER    0x0001
+#define PCI_EXT_CAP_ID_VC     0x0002
+#define PCI_EXT_CAP_ID_DSN    0x0003
+#define PCI_EXT_CAP_ID_PWR    0x0004
+#define PCI_EXT_CAP_ID_VNDR   0x000B
+#define PCI_EXT_CAP_ID_ACS    0x000D
+#define PCI_EXT_CAP_ID_ARI    0x000E
+#define PCI_EXT_CAP_ID_ATS    0x000F
+#define PCI_EXT_CAP_ID_SRIOV  0x0010
+#define PCI_EXT_CAP_ID_LTR    0x0018
+#define PCI_EXT_CAP_ID_SECPCI 0x0019
+#define PCI_EXT_CAP_ID_PASID  0x001B
+#define PCI_EXT_CAP_ID_L1SS   0x001E
+#define PCI_EXT_CAP_ID_DLF    0x0025
+#define PCI_EXT_CAP_ID_PL_16GT 0x0026
+
+#define PCI_EXT_CAP_ID(hdr)    ((uint16_t)((hdr) & 0xFFFF))
+#define PCI_EXT_CAP_VER(hdr)   ((uint8_t)(((hdr) >> 16) & 0xF))
+#define PCI_EXT_CAP_NEXT(hdr)  ((uint16_t)(((hdr) >> 20) & 0xFFC))
+
+#define PCI_EXP_FLAGS         0x02
+#define PCI_EXP_DEVCAP        0x04
+#define PCI_EXP_DEVCTL        0x08
+#define PCI_EXP_DEVSTA        0x0A
+#define PCI_EXP_LNKCAP        0x0C
+#define PCI_EXP_LNKCTL        0x10
+#define PCI_EXP_LNKSTA        0x12
+#define PCI_EXP_DEVCTL2       0x28
+
+#define PCI_EXP_FLAGS_TYPE(flags)  ((uint8_t)(((flags) >> 4) & 0xF))
+#define PCI_EXP_LNKCAP_SPEED(cap)  ((uint8_t)((cap) & 0xF))
+#define PCI_EXP_LNKCAP_WIDTH(cap)  ((uint8_t)(((cap) >> 4) & 0x3F))
+#define PCI_EXP_LNKSTA_SPEED(sta)  ((uint8_t)((sta) & 0xF))
+#define PCI_EXP_LNKSTA_WIDTH(sta)  ((uint8_t)(((sta) >> 4) & 0x3F))
+
+#define PCI_EXP_DEVCAP_PAYLOAD(cap)   ((uint8_t)((cap) & 0x7))
+#define PCI_EXP_DEVCAP_L0S_ACC(cap)   ((uint8_t)(((cap) >> 6) & 0x7))
+#define PCI_EXP_DEVCAP_L1_ACC(cap)    ((uint8_t)(((cap) >> 9) & 0x7))
+#define PCI_EXP_DEVCTL_RELAX_EN       0x0010
+#define PCI_EXP_DEVCTL_PAYLOAD(ctl)   ((uint8_t)(((ctl) >> 5) & 0x7))
+#define PCI_EXP_DEVCTL_READRQ(ctl)    ((uint8_t)(((ctl) >> 12) & 0x7))
+#define PCI_EXP_LNKCAP_ASPMS(cap)     ((uint8_t)(((cap) >> 10) & 0x3))
+#define PCI_EXP_LNKCAP_L0SEL(cap)     ((uint8_t)(((cap) >> 12) & 0x7))
+#define PCI_EXP_LNKCAP_L1EL(cap)      ((uint8_t)(((cap) >> 15) & 0x7))
+#define PCI_EXP_LNKCTL_ASPMC(ctl)     ((uint8_t)((ctl) & 0x3))
+#define PCI_EXP_ASPM_L0S              0x1
+#define PCI_EXP_ASPM_L1               0x2
+#define PCI_EXP_DEVCTL2_ARI           0x0020
+
+#define PCI_EXP_TYPE_ENDPOINT     0x0
+#define PCI_EXP_TYPE_LEG_END      0x1
+#define PCI_EXP_TYPE_ROOT_PORT    0x4
+#define PCI_EXP_TYPE_UPSTREAM     0x5
+#define PCI_EXP_TYPE_DOWNSTREAM   0x6
+#define PCI_EXP_TYPE_PCI_BRIDGE   0x7
+#define PCI_EXP_TYPE_PCIE_BRIDGE  0x8
+#define PCI_EXP_TYPE_RC_END       0x9
+#define PCI_EXP_TYPE_RC_EC        0xA
+
+#define PCI_AER_UNCOR_STATUS    0x04
+#define PCI_AER_UNCOR_SEVERITY  0x0C
+#define PCI_AER_COR_STATUS      0x10
+
+#define PCI_SRIOV_CAP         0x04
+#define PCI_SRIOV_CTRL        0x08
+#define PCI_SRIOV_STATUS      0x0A
+#define PCI_SRIOV_INITIAL_VF  0x0C
+#define PCI_SRIOV_TOTAL_VF    0x0E
+#define PCI_SRIOV_NUM_VF      0x10
+#define PCI_SRIOV_FUNC_LINK   0x12
+#define PCI_SRIOV_VF_OFFSET   0x14
+#define PCI_SRIOV_VF_STRIDE   0x16
+#define PCI_SRIOV_VF_DID      0x1A
+
+#define PCI_SRIOV_CTRL_VFE    0x0001
+#define PCI_SRIOV_CTRL_ARI    0x0010
+
+#define PCI_ARI_CAP           0x04
+#define PCI_ARI_NEXT(cap)     ((uint8_t)(((cap) >> 8) & 0xFF))
\ No newline at end of file
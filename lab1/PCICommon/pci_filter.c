@@ -0,0 +1,50 @@
+#include "pci_filter.h"
+
+typedef char PciFilterSizeCheck[sizeof(PCI_FILTER) == 12 + 4 * PCI_FILTER_MAX_IDS ? 1 : -1];
+
+//   (Flags == 0)  .    base:sub  ,
+//  -    vendor:device,  device 0xFFFF   
+int PciFilterMatch(const PCI_FILTER* filter, uint8_t bus, uint32_t idDword, uint32_t classDword) {
+    uint16_t classCode;
+    uint16_t count;
+    uint16_t i;
+
+    if (!filter || !filter->Flags) {
+        return 1;
+    }
+
+    if ((filter->Flags & PCI_FILTER_BUS_RANGE) && (bus < filter->BusFirst || bus > filter->BusLast)) {
+        return 0;
+    }
+
+    if (filter->Flags & PCI_FILTER_CLASS) {
+        classCode = (uint16_t)((PCI_CLASS_BASE(classDword) << 8) | PCI_CLASS_SUB(classDword));
+        if ((classCode & filter->ClassMask) != (filter->ClassCode & filter->ClassMask)) {
+            return 0;
+        }
+    }
+
+    if (filter->Flags & PCI_FILTER_IDS) {
+        count = filter->IdCount < PCI_FILTER_MAX_IDS ? filter->IdCount : PCI_FILTER_MAX_IDS;
+        for (i = 0; i < count; i++) {
+            uint32_t id = filter->Ids[i];
+            if (PCI_ID_VENDOR(id) == PCI_ID_VENDOR(idDword) &&
+                (PCI_ID_DEVICE(id) == PCI_FILTER_ANY_DEVICE || PCI_ID_DEVICE(id) == PCI_ID_DEVICE(idDword))) {
+                break;
+            }
+        }
+        if (i == count) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+//        first..last
+int PciFilterBusOverlaps(const PCI_FILTER* filter, uint8_t first, uint8_t last) {
+    if (!filter || !(filter->Flags & PCI_FILTER_BUS_RANGE)) {
+        return 1;
+    }
+    return first <= filter->BusLast && last >= filter->BusFirst;
+}
\ No newline at end of file
@@ -0,0 +1,37 @@
+#pragma once
+#include "pci_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PCI_FILTER_MAX_IDS  16
+#define PCI_FILTER_ANY_DEVICE  0xFFFF
+
+#define PCI_FILTER_CLASS      0x0001
+#define PCI_FILTER_IDS        0x0002
+#define PCI_FILTER_BUS_RANGE  0x0004
+
+#define PCI_FILTER_ID(vendor, device)  ((uint32_t)(vendor) | ((uint32_t)(device) << 16))
+
+#pragma pack(push, 1)
+
+typedef struct _PCI_FILTER {
+    uint16_t Flags;
+    uint8_t BusFirst;
+    uint8_t BusLast;
+    uint16_t ClassCode;
+    uint16_t ClassMask;
+    uint16_t IdCount;
+    uint16_t Reserved;
+    uint32_t Ids[PCI_FILTER_MAX_IDS];
+} PCI_FILTER, * PPCI_FILTER;
+
+#pragma pack(pop)
+
+int PciFilterMatch(const PCI_FILTER* filter, uint8_t bus, uint32_t idDword, uint32_t classDword);
+int PciFilterBusOverlaps(const PCI_FILTER* filter, uint8_t first, uint8_t last);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
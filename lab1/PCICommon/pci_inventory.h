@@ -0,0 +1,40 @@
+#pragma once
+#include <stdint.h>
+
+#define PCI_INVENTORY_MAGIC      0x564E4950u
+#define PCI_INVENTORY_VERSION    1
+#define PCI_INVENTORY_HOST_SIZE  64
+
+#pragma pack(push, 1)
+
+typedef struct _PCI_INVENTORY_HEADER {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t RecordSize;
+    uint32_t RecordCount;
+    uint32_t Flags;
+    uint64_t Timestamp;
+    char HostName[PCI_INVENTORY_HOST_SIZE];
+} PCI_INVENTORY_HEADER, * PPCI_INVENTORY_HEADER;
+
+typedef struct _PCI_INVENTORY_RECORD {
+    uint16_t Segment;
+    uint8_t Bus;
+    uint8_t DevFn;
+    uint16_t VendorID;
+    uint16_t DeviceID;
+    uint8_t Revision;
+    uint8_t ProgIF;
+    uint8_t SubClass;
+    uint8_t BaseClass;
+    uint16_t SubsystemVendorID;
+    uint16_t SubsystemID;
+    uint8_t HeaderType;
+    uint8_t LinkSpeed;
+    uint8_t LinkWidth;
+    uint8_t Reserved;
+} PCI_INVENTORY_RECORD, * PPCI_INVENTORY_RECORD;
+
+#pragma pack(pop)
+
+#define PCI_INVENTORY_KEY(record)  (((uint32_t)(record)->Segment << 16) | ((uint32_t)(record)->Bus << 8) | (record)->DevFn)
\ No newline at end of file
@@ -0,0 +1,178 @@
+#include "pci_ring.h"
+#include "pci_config.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+typedef char PciRingHeaderSizeCheck[sizeof(PCI_RING_HEADER) == 3 * PCI_RING_CACHE_LINE ? 1 : -1];
+
+// Head   , Tail -  ;    
+//  .      ,  -   
+#if defined(_MSC_VER)
+#if defined(_M_ARM64)
+#define PCI_RING_FENCE() __dmb(_ARM64_BARRIER_ISH)
+#else
+#define PCI_RING_FENCE() _ReadWriteBarrier()
+#endif
+
+static uint32_t PciRingLoadAcquire(const volatile uint32_t* value) {
+    uint32_t result = *value;
+    PCI_RING_FENCE();
+    return result;
+}
+
+static void PciRingStoreRelease(volatile uint32_t* value, uint32_t data) {
+    PCI_RING_FENCE();
+    *value = data;
+}
+#else
+static uint32_t PciRingLoadAcquire(const volatile uint32_t* value) {
+    return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static void PciRingStoreRelease(volatile uint32_t* value, uint32_t data) {
+    __atomic_store_n(value, data, __ATOMIC_RELEASE);
+}
+#endif
+
+static int PciRingIsPowerOfTwo(uint32_t value) {
+    return value && !(value & (value - 1));
+}
+
+static uint8_t* PciRingSlot(const PCI_RING* ring, uint32_t index) {
+    return ring->Slots + (uint64_t)(index & (ring->Capacity - 1)) * ring->RecordSize;
+}
+
+uint32_t PciRingSize(uint32_t capacity, uint16_t configSize) {
+    return (uint32_t)sizeof(PCI_RING_HEADER) + capacity * ((uint32_t)sizeof(PCI_WIRE_RECORD) + configSize);
+}
+
+//       ,     
+int PciRingInit(PCI_RING* ring, void* memory, uint32_t size, uint32_t capacity, uint16_t configSize) {
+    PPCI_RING_HEADER header = (PPCI_RING_HEADER)memory;
+
+    if (!PciRingIsPowerOfTwo(capacity) || capacity > PCI_RING_MAX_CAPACITY ||
+        configSize > PCI_CFG_EXT_SPACE_SIZE || (configSize & 3) ||
+        size < PciRingSize(capacity, configSize)) {
+        return 0;
+    }
+
+    header->Magic = PCI_RING_MAGIC;
+    header->Version = PCI_RING_VERSION;
+    header->RecordSize = (uint16_t)(sizeof(PCI_WIRE_RECORD) + configSize);
+    header->Capacity = capacity;
+    header->ConfigSize = configSize;
+    header->Reserved = 0;
+
+    ring->Header = header;
+    ring->Slots = (uint8_t*)(header + 1);
+    ring->Capacity = capacity;
+    ring->RecordSize = header->RecordSize;
+    ring->ConfigSize = configSize;
+    PciRingReset(ring);
+    return 1;
+}
+
+//       :    
+//   ,        
+int PciRingAttach(PCI_RING* ring, void* memory, uint32_t size) {
+    const PCI_RING_HEADER* header = (const PCI_RING_HEADER*)memory;
+
+    if (size < sizeof(PCI_RING_HEADER) || header->Magic != PCI_RING_MAGIC || header->Version != PCI_RING_VERSION) {
+        return 0;
+    }
+    if (!PciRingIsPowerOfTwo(header->Capacity) || header->Capacity > PCI_RING_MAX_CAPACITY ||
+        header->RecordSize < sizeof(PCI_WIRE_RECORD) + header->ConfigSize ||
+        (uint64_t)header->Capacity * header->RecordSize > size - sizeof(PCI_RING_HEADER)) {
+        return 0;
+    }
+
+    ring->Header = (PPCI_RING_HEADER)memory;
+    ring->Slots = (uint8_t*)memory + sizeof(PCI_RING_HEADER);
+    ring->Capacity = header->Capacity;
+    ring->RecordSize = header->RecordSize;
+    ring->ConfigSize = header->ConfigSize;
+    ring->Index = 0;
+    ring->Count = 0;
+    return 1;
+}
+
+//       -     DONE
+//      ,    
+void PciRingReset(PCI_RING* ring) {
+    ring->Index = 0;
+    ring->Count = 0;
+    ring->Header->TotalCount = 0;
+    ring->Header->Head = 0;
+    ring->Header->Tail = 0;
+    ring->Header->Cancel = 0;
+    PciRingStoreRelease(&ring->Header->State, PCI_RING_RUNNING);
+}
+
+//      ,     
+void PciRingBegin(PCI_RING* ring) {
+    ring->Index = 0;
+    ring->Count = 0;
+}
+
+//    NULL,   
+PCI_WIRE_RECORD* PciRingReserve(PCI_RING* ring) {
+    uint32_t tail = PciRingLoadAcquire(&ring->Header->Tail);
+
+    if (ring->Index - tail >= ring->Capacity) {
+        return 0;
+    }
+    return (PCI_WIRE_RECORD*)PciRingSlot(ring, ring->Index);
+}
+
+//          
+void PciRingCommit(PCI_RING* ring) {
+    ring->Index++;
+    ring->Count++;
+    PciRingStoreRelease(&ring->Header->Head, ring->Index);
+}
+
+int PciRingIsCancelled(const PCI_RING* ring) {
+    return PciRingLoadAcquire(&ring->Header->Cancel) != 0;
+}
+
+void PciRingFinish(PCI_RING* ring, uint32_t state) {
+    ring->Header->TotalCount = ring->Count;
+    PciRingStoreRelease(&ring->Header->State, state);
+}
+
+//      PciRingRelease -     
+const PCI_WIRE_RECORD* PciRingPeek(PCI_RING* ring) {
+    uint32_t head = PciRingLoadAcquire(&ring->Header->Head);
+
+    if (head == ring->Index || head - ring->Index > ring->Capacity) {
+        return 0;
+    }
+    return (const PCI_WIRE_RECORD*)PciRingSlot(ring, ring->Index);
+}
+
+void PciRingRelease(PCI_RING* ring) {
+    ring->Index++;
+    ring->Count++;
+    PciRingStoreRelease(&ring->Header->Tail, ring->Index);
+}
+
+//    Head:     ,
+//   ,     
+uint32_t PciRingPoll(PCI_RING* ring) {
+    uint32_t state = PciRingLoadAcquire(&ring->Header->State);
+
+    if (state != PCI_RING_RUNNING && PciRingLoadAcquire(&ring->Header->Head) != ring->Index) {
+        return PCI_RING_RUNNING;
+    }
+    return state;
+}
+
+void PciRingCancel(PCI_RING* ring) {
+    PciRingStoreRelease(&ring->Header->Cancel, 1);
+}
+
+uint8_t* PciRingRecordConfig(const PCI_RING* ring, const PCI_WIRE_RECORD* record) {
+    return (uint8_t*)record + ring->RecordSize - ring->ConfigSize;
+}
\ No newline at end of file
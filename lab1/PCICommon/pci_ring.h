@@ -0,0 +1,87 @@
+#pragma once
+#include <stdint.h>
+#include "pci_wire.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PCI_RING_MAGIC    0x474E5250u
+#define PCI_RING_VERSION  2
+
+#define PCI_RING_CACHE_LINE    64
+#define PCI_RING_MAX_CAPACITY  65536
+
+#define PCI_RING_RUNNING   0
+#define PCI_RING_DONE      1
+#define PCI_RING_STALLED   2
+
+#ifdef CTL_CODE
+#define IOCTL_PCI_MAP_RING   CTL_CODE(FILE_DEVICE_UNKNOWN, 0x802, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#define IOCTL_PCI_SCAN_RING  CTL_CODE(FILE_DEVICE_UNKNOWN, 0x803, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#endif
+
+#pragma pack(push, 1)
+
+typedef struct _PCI_RING_HEADER {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t RecordSize;
+    uint32_t Capacity;
+    uint16_t ConfigSize;
+    uint16_t Reserved;
+    volatile uint32_t State;
+    uint32_t TotalCount;
+    uint8_t Padding0[PCI_RING_CACHE_LINE - 24];
+    volatile uint32_t Head;
+    uint8_t Padding1[PCI_RING_CACHE_LINE - 4];
+    volatile uint32_t Tail;
+    volatile uint32_t Cancel;
+    uint8_t Padding2[PCI_RING_CACHE_LINE - 8];
+} PCI_RING_HEADER, * PPCI_RING_HEADER;
+
+typedef struct _PCI_RING_MAP_REQUEST {
+    uint16_t Version;
+    uint16_t ConfigSize;
+    uint32_t Capacity;
+} PCI_RING_MAP_REQUEST, * PPCI_RING_MAP_REQUEST;
+
+typedef struct _PCI_RING_MAP_RESPONSE {
+    uint64_t Address;
+    uint32_t Size;
+    uint32_t Reserved;
+} PCI_RING_MAP_RESPONSE, * PPCI_RING_MAP_RESPONSE;
+
+#pragma pack(pop)
+
+typedef struct _PCI_RING {
+    PPCI_RING_HEADER Header;
+    uint8_t* Slots;
+    uint32_t Capacity;
+    uint16_t RecordSize;
+    uint16_t ConfigSize;
+    uint32_t Index;
+    uint32_t Count;
+} PCI_RING, * PPCI_RING;
+
+uint32_t PciRingSize(uint32_t capacity, uint16_t configSize);
+int PciRingInit(PCI_RING* ring, void* memory, uint32_t size, uint32_t capacity, uint16_t configSize);
+int PciRingAttach(PCI_RING* ring, void* memory, uint32_t size);
+void PciRingReset(PCI_RING* ring);
+
+void PciRingBegin(PCI_RING* ring);
+PCI_WIRE_RECORD* PciRingReserve(PCI_RING* ring);
+void PciRingCommit(PCI_RING* ring);
+int PciRingIsCancelled(const PCI_RING* ring);
+void PciRingFinish(PCI_RING* ring, uint32_t state);
+
+const PCI_WIRE_RECORD* PciRingPeek(PCI_RING* ring);
+void PciRingRelease(PCI_RING* ring);
+uint32_t PciRingPoll(PCI_RING* ring);
+void PciRingCancel(PCI_RING* ring);
+
+uint8_t* PciRingRecordConfig(const PCI_RING* ring, const PCI_WIRE_RECORD* record);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
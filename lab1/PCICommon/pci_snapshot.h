@@ -0,0 +1,34 @@
+#pragma once
+#include <stdint.h>
+
+#define PCI_SNAPSHOT_MAGIC    0x50414E53u
+#define PCI_SNAPSHOT_VERSION  1
+
+#pragma pack(push, 1)
+
+typedef struct _PCI_SNAPSHOT_HEADER {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t EntrySize;
+    uint32_t EntryCount;
+    uint32_t Reserved;
+} PCI_SNAPSHOT_HEADER, * PPCI_SNAPSHOT_HEADER;
+
+typedef struct _PCI_SNAPSHOT_ENTRY {
+    uint16_t Segment;
+    uint8_t Bus;
+    uint8_t DevFn;
+    uint32_t ConfigOffset;
+    uint32_t ConfigSize;
+    uint32_t Reserved;
+} PCI_SNAPSHOT_ENTRY, * PPCI_SNAPSHOT_ENTRY;
+
+typedef struct _PCI_SNAPSHOT_RESOURCES {
+    uint64_t BarSize[6];
+} PCI_SNAPSHOT_RESOURCES, * PPCI_SNAPSHOT_RESOURCES;
+
+#pragma pack(pop)
+
+#define PCI_DEVFN(device, function)  ((uint8_t)(((device) << 3) | ((function) & 7)))
+#define PCI_DEVFN_DEVICE(devfn)      ((uint8_t)((devfn) >> 3))
+#define PCI_DEVFN_FUNCTION(devfn)    ((uint8_t)((devfn) & 7))
\ No newline at end of file
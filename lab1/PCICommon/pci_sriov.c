@@ -0,0 +1,40 @@
+#include "pci_sriov.h"
+
+//  capability SR-IOV   offset,  .
+// VF ,    VF Enable. NumVFs  TotalVFs - 
+// ,  VF  .     dword   
+int PciSriovRead(const PCI_CAP_SOURCE* source, uint16_t offset, PCI_SRIOV* sriov) {
+    uint32_t control, counts, routing;
+
+    if (!offset || offset + PCI_SRIOV_VF_DID + 2u > source->ConfigSize) {
+        return 0;
+    }
+
+    control = source->Read(source->Context, (uint16_t)(offset + PCI_SRIOV_CTRL));
+    if (!(control & PCI_SRIOV_CTRL_VFE)) {
+        return 0;
+    }
+
+    counts = source->Read(source->Context, (uint16_t)(offset + PCI_SRIOV_INITIAL_VF));
+    routing = source->Read(source->Context, (uint16_t)(offset + PCI_SRIOV_VF_OFFSET));
+
+    sriov->NumVFs = (uint16_t)source->Read(source->Context, (uint16_t)(offset + PCI_SRIOV_NUM_VF));
+    if (sriov->NumVFs > (uint16_t)(counts >> 16)) {
+        sriov->NumVFs = (uint16_t)(counts >> 16);
+    }
+    sriov->FirstOffset = (uint16_t)routing;
+    sriov->Stride = (uint16_t)(routing >> 16);
+    if (sriov->Stride == 0 && sriov->NumVFs > 1) {
+        sriov->NumVFs = 1;
+    }
+    sriov->VfDeviceID = (uint16_t)(source->Read(source->Context, (uint16_t)(offset + PCI_SRIOV_VF_DID - 2)) >> 16);
+
+    return sriov->NumVFs != 0 && sriov->FirstOffset != 0;
+}
+
+// Routing ID VF   index ( ). VF     ,
+//     16-  
+uint32_t PciSriovVfRid(uint16_t pfRid, const PCI_SRIOV* sriov, uint16_t index) {
+    uint32_t rid = (uint32_t)pfRid + sriov->FirstOffset + (uint32_t)index * sriov->Stride;
+    return rid > 0xFFFF ? PCI_SRIOV_NO_RID : rid;
+}
\ No newline at end of file
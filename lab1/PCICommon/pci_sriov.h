@@ -0,0 +1,22 @@
+#pragma once
+#include "pci_caps.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PCI_SRIOV_NO_RID  0xFFFFFFFFu
+
+typedef struct _PCI_SRIOV {
+    uint16_t NumVFs;
+    uint16_t FirstOffset;
+    uint16_t Stride;
+    uint16_t VfDeviceID;
+} PCI_SRIOV, * PPCI_SRIOV;
+
+int PciSriovRead(const PCI_CAP_SOURCE* source, uint16_t offset, PCI_SRIOV* sriov);
+uint32_t PciSriovVfRid(uint16_t pfRid, const PCI_SRIOV* sriov, uint16_t index);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
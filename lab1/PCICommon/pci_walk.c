@@ -0,0 +1,327 @@
+#include "pci_walk.h"
+#include "pci_sriov.h"
+
+//   :  (32   8 )  ARI,  8-
+//      .     
+// ARI-    256 ,  -   Next Function Number
+#define PCI_WALK_ARI_NONE   0
+#define PCI_WALK_ARI_PROBE  1
+#define PCI_WALK_ARI_CHAIN  2
+
+//    :       
+typedef struct _PCI_WALK_FRAME {
+    uint8_t Bus;
+    uint8_t Device;
+    uint8_t Function;
+    uint8_t FunctionLimit;
+    uint8_t Ari;
+    uint8_t AriNext;
+} PCI_WALK_FRAME;
+
+typedef struct _PCI_WALK_STATE {
+    const PCI_WALK_OPS* Ops;
+    PCI_WALK_STATS* Stats;
+    uint32_t Visited[PCI_MAX_BUSES / 32];
+    PCI_WALK_FRAME Stack[PCI_MAX_BUSES];
+    uint32_t Depth;
+} PCI_WALK_STATE;
+
+typedef struct _PCI_WALK_CAP_CONTEXT {
+    PCI_WALK_STATE* State;
+    const PCI_WALK_FUNCTION* Function;
+} PCI_WALK_CAP_CONTEXT;
+
+static uint32_t PciWalkRead(PCI_WALK_STATE* state, const PCI_WALK_FUNCTION* info, uint16_t offset) {
+    state->Stats->ConfigReads++;
+    return state->Ops->ReadConfig(state->Ops->Context, info->Bus, info->Device, info->Function, offset);
+}
+
+static uint32_t PciWalkCapRead(void* context, uint16_t offset) {
+    PCI_WALK_CAP_CONTEXT* cap = (PCI_WALK_CAP_CONTEXT*)context;
+    return PciWalkRead(cap->State, cap->Function, offset);
+}
+
+//  capability  ReadConfig;  - ,    
+static void PciWalkCapSource(PCI_WALK_STATE* state, const PCI_WALK_FUNCTION* info, PCI_WALK_CAP_CONTEXT* context,
+    PCI_CAP_SOURCE* source, uint16_t configSize) {
+    context->State = state;
+    context->Function = info;
+    source->Read = PciWalkCapRead;
+    source->Context = context;
+    source->ConfigSize = configSize;
+}
+
+static uint16_t PciWalkConfigSize(const PCI_WALK_STATE* state) {
+    return state->Ops->ConfigSize ? state->Ops->ConfigSize : PCI_CFG_SPACE_SIZE;
+}
+
+//    ,    ,    
+static void PciWalkReadFields(PCI_WALK_STATE* state, PCI_WALK_FUNCTION* info, uint32_t* header) {
+    uint8_t type;
+
+    if (state->Ops->ReadHeader) {
+        state->Stats->ConfigReads += PCI_CFG_HEADER_DWORDS;
+        state->Ops->ReadHeader(state->Ops->Context, info->Bus, info->Device, info->Function, header);
+
+        info->Header = header;
+        info->IdDword = header[PCI_CFG_ID / 4];
+        info->ClassDword = header[PCI_CFG_CLASS_REV / 4];
+        info->HeaderType = PCI_HEADER_TYPE(header[PCI_CFG_HEADER / 4]);
+
+        type = info->HeaderType & PCI_HEADER_TYPE_MASK;
+        if (type == PCI_HEADER_TYPE_BRIDGE) {
+            info->SecondaryBus = PCI_BUS_SECONDARY(header[PCI_CFG_BUS_NUMBERS / 4]);
+            info->SubordinateBus = PCI_BUS_SUBORDINATE(header[PCI_CFG_BUS_NUMBERS / 4]);
+        }
+        else if (type == PCI_HEADER_TYPE_NORMAL) {
+            info->SubsystemDword = header[PCI_CFG_SUBSYSTEM / 4];
+        }
+        return;
+    }
+
+    info->HeaderType = PCI_HEADER_TYPE(PciWalkRead(state, info, PCI_CFG_HEADER));
+    info->ClassDword = PciWalkRead(state, info, PCI_CFG_CLASS_REV);
+
+    type = info->HeaderType & PCI_HEADER_TYPE_MASK;
+    if (type == PCI_HEADER_TYPE_BRIDGE) {
+        uint32_t busNumbers = PciWalkRead(state, info, PCI_CFG_BUS_NUMBERS);
+        info->SecondaryBus = PCI_BUS_SECONDARY(busNumbers);
+        info->SubordinateBus = PCI_BUS_SUBORDINATE(busNumbers);
+    }
+    else if (type == PCI_HEADER_TYPE_NORMAL) {
+        info->SubsystemDword = PciWalkRead(state, info, PCI_CFG_SUBSYSTEM);
+    }
+}
+
+//    ARI Forwarding      1-31
+//    -    8-255 ARI-
+static int PciWalkAriForwarding(PCI_WALK_STATE* state, const PCI_WALK_FUNCTION* bridge) {
+    PCI_WALK_CAP_CONTEXT context;
+    PCI_CAP_SOURCE source;
+    uint16_t pcie;
+
+    PciWalkCapSource(state, bridge, &context, &source, PCI_CFG_SPACE_SIZE);
+    pcie = PciCapFind(&source, PCI_CAP_ID_EXP);
+    return pcie && (PciWalkRead(state, bridge, (uint16_t)(pcie + PCI_EXP_DEVCTL2)) & PCI_EXP_DEVCTL2_ARI);
+}
+
+//        ARI,  SR-IOV
+static void PciWalkFindExtended(PCI_WALK_STATE* state, const PCI_WALK_FUNCTION* info, PCI_CAP_SOURCE* source,
+    PCI_WALK_CAP_CONTEXT* context, uint16_t* ari, uint16_t* sriov) {
+    PCI_CAP_CURSOR cursor;
+    PCI_CAPABILITY capability;
+
+    PciWalkCapSource(state, info, context, source, PciWalkConfigSize(state));
+    cursor.Extended = 1;
+    cursor.Next = PCI_CFG_EXT_CAP_START;
+    cursor.Remaining = (PCI_CFG_EXT_SPACE_SIZE - PCI_CFG_EXT_CAP_START) / 8;
+
+    while (PciCapNext(source, &cursor, &capability)) {
+        if (capability.Id == PCI_EXT_CAP_ID_ARI) {
+            *ari = capability.Offset;
+        }
+        else if (capability.Id == PCI_EXT_CAP_ID_SRIOV) {
+            *sriov = capability.Offset;
+        }
+    }
+}
+
+// VF     Vendor ID,     .  Routing ID
+//   First VF Offset  VF Stride,    PF
+//   capability:      ,    VF
+static int PciWalkVirtualFunctions(PCI_WALK_STATE* state, const PCI_WALK_FUNCTION* pf, const PCI_CAP_SOURCE* source, uint16_t offset) {
+    PCI_SRIOV sriov;
+    uint16_t pfRid = (uint16_t)((pf->Bus << 8) | (pf->Device << 3) | pf->Function);
+    uint16_t i;
+
+    if (!PciSriovRead(source, offset, &sriov)) {
+        return 1;
+    }
+
+    for (i = 0; i < sriov.NumVFs; i++) {
+        PCI_WALK_FUNCTION vf = { 0 };
+        uint32_t header[PCI_CFG_HEADER_DWORDS];
+        uint32_t rid = PciSriovVfRid(pfRid, &sriov, i);
+
+        if (rid == PCI_SRIOV_NO_RID) {
+            break;
+        }
+
+        vf.Bus = (uint8_t)(rid >> 8);
+        vf.Device = (uint8_t)((rid >> 3) & 0x1F);
+        vf.Function = (uint8_t)(rid & 7);
+        if (state->Ops->ReadHeader) {
+            PciWalkReadFields(state, &vf, header);
+        }
+        else {
+            vf.ClassDword = PciWalkRead(state, &vf, PCI_CFG_CLASS_REV);
+            vf.SubsystemDword = PciWalkRead(state, &vf, PCI_CFG_SUBSYSTEM);
+        }
+
+        vf.IdDword = PCI_ID_VENDOR(pf->IdDword) | ((uint32_t)sriov.VfDeviceID << 16);
+        vf.HeaderType = PCI_HEADER_TYPE_NORMAL;
+        vf.SecondaryBus = 0;
+        vf.SubordinateBus = 0;
+        vf.Virtual = 1;
+        vf.PhysicalFunction = pfRid;
+
+        state->Stats->FunctionsFound++;
+        state->Stats->VirtualFunctions++;
+        if (PciFilterMatch(state->Ops->Filter, vf.Bus, vf.IdDword, vf.ClassDword) && !state->Ops->Visit(state->Ops->Context, &vf)) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int PciWalkIsVisited(const PCI_WALK_STATE* state, uint8_t bus) {
+    return (state->Visited[bus >> 5] >> (bus & 31)) & 1;
+}
+
+//       ,     256
+static void PciWalkPushBus(PCI_WALK_STATE* state, uint8_t bus, int ari) {
+    PCI_WALK_FRAME* frame;
+
+    if (PciWalkIsVisited(state, bus)) {
+        return;
+    }
+
+    state->Visited[bus >> 5] |= 1u << (bus & 31);
+    state->Stats->BusesScanned++;
+
+    frame = &state->Stack[state->Depth++];
+    frame->Bus = bus;
+    frame->Device = 0;
+    frame->Function = 0;
+    frame->FunctionLimit = 1;
+    frame->Ari = ari ? PCI_WALK_ARI_PROBE : PCI_WALK_ARI_NONE;
+    frame->AriNext = 0;
+}
+
+//   ARI   8-;      
+static void PciWalkAdvance(PCI_WALK_FRAME* frame) {
+    if (frame->Ari != PCI_WALK_ARI_NONE) {
+        uint32_t number = ((uint32_t)frame->Device << 3) | frame->Function;
+        uint32_t next = (frame->Ari == PCI_WALK_ARI_CHAIN) ? frame->AriNext : number + 1;
+
+        if (next <= number) {
+            next = PCI_MAX_DEVICES * PCI_MAX_FUNCTIONS;
+        }
+        frame->Device = (uint8_t)(next >> 3);
+        frame->Function = (uint8_t)(next & 7);
+        return;
+    }
+
+    if (frame->Function + 1 < frame->FunctionLimit) {
+        frame->Function++;
+        return;
+    }
+
+    frame->Device++;
+    frame->Function = 0;
+    frame->FunctionLimit = 1;
+}
+
+PCI_WALK_RESULT PciWalkTopology(const PCI_WALK_OPS* ops, PCI_WALK_STATS* stats) {
+    PCI_WALK_STATE state = { 0 };
+    uint8_t defaultRoot = 0;
+    const uint8_t* roots;
+    uint32_t rootCount;
+    uint32_t i;
+
+    if (!ops || !ops->ReadConfig || !ops->Visit || !stats) {
+        return PCI_WALK_INVALID_ARGS;
+    }
+
+    stats->ConfigReads = 0;
+    stats->FunctionsFound = 0;
+    stats->BusesScanned = 0;
+    stats->VirtualFunctions = 0;
+
+    state.Ops = ops;
+    state.Stats = stats;
+
+    roots = ops->RootBusCount ? ops->RootBuses : &defaultRoot;
+    rootCount = ops->RootBusCount ? ops->RootBusCount : 1;
+
+    for (i = 0; i < rootCount; i++) {
+        PciWalkPushBus(&state, roots[i], 0);
+
+        while (state.Depth > 0) {
+            PCI_WALK_FRAME* frame = &state.Stack[state.Depth - 1];
+            PCI_WALK_FUNCTION info = { 0 };
+            PCI_WALK_CAP_CONTEXT context;
+            PCI_CAP_SOURCE source;
+            uint32_t header[PCI_CFG_HEADER_DWORDS];
+            uint16_t ari = 0, sriov = 0;
+            uint32_t id;
+
+            if (frame->Device >= PCI_MAX_DEVICES) {
+                state.Depth--;
+                continue;
+            }
+
+            info.Bus = frame->Bus;
+            info.Device = frame->Device;
+            info.Function = frame->Function;
+            frame->AriNext = 0;
+
+            //   0    -  1-7  
+            id = PciWalkRead(&state, &info, PCI_CFG_ID);
+            if (PCI_ID_VENDOR(id) == PCI_INVALID_VENDOR_ID) {
+                PciWalkAdvance(frame);
+                continue;
+            }
+
+            //         -  
+            info.IdDword = id;
+            PciWalkReadFields(&state, &info, header);
+            if (PCI_ID_VENDOR(info.IdDword) == PCI_INVALID_VENDOR_ID) {
+                PciWalkAdvance(frame);
+                continue;
+            }
+
+            //  capability     (CF8/CFC  256 )
+            if (PciWalkConfigSize(&state) > PCI_CFG_SPACE_SIZE &&
+                (info.HeaderType & PCI_HEADER_TYPE_MASK) == PCI_HEADER_TYPE_NORMAL) {
+                PciWalkFindExtended(&state, &info, &source, &context, &ari, &sriov);
+            }
+
+            //  ARI capability   0   ARI-   
+            if (frame->Ari == PCI_WALK_ARI_PROBE && info.Device == 0 && info.Function == 0 &&
+                PciWalkConfigSize(&state) > PCI_CFG_SPACE_SIZE) {
+                frame->Ari = ari ? PCI_WALK_ARI_CHAIN : PCI_WALK_ARI_NONE;
+            }
+            if (frame->Ari == PCI_WALK_ARI_CHAIN && ari) {
+                frame->AriNext = PCI_ARI_NEXT(PciWalkRead(&state, &info, (uint16_t)(ari + PCI_ARI_CAP)));
+            }
+
+            if (frame->Ari == PCI_WALK_ARI_NONE && info.Function == 0 && (info.HeaderType & PCI_HEADER_MULTIFUNCTION)) {
+                frame->FunctionLimit = PCI_MAX_FUNCTIONS;
+            }
+
+            stats->FunctionsFound++;
+            PciWalkAdvance(frame);
+
+            //     ,        
+            if (PciFilterMatch(ops->Filter, info.Bus, info.IdDword, info.ClassDword) && !ops->Visit(ops->Context, &info)) {
+                return PCI_WALK_STOPPED;
+            }
+
+            // VF    : PF    ,   VF - 
+            if (sriov && !PciWalkVirtualFunctions(&state, &info, &source, sriov)) {
+                return PCI_WALK_STOPPED;
+            }
+
+            //    ,      .
+            //   (  0)      ,
+            //   ,      
+            if (info.SecondaryBus > info.Bus && info.SubordinateBus >= info.SecondaryBus &&
+                PciFilterBusOverlaps(ops->Filter, info.SecondaryBus, info.SubordinateBus)) {
+                PciWalkPushBus(&state, info.SecondaryBus, PciWalkAriForwarding(&state, &info));
+            }
+        }
+    }
+
+    return PCI_WALK_COMPLETED;
+}
\ No newline at end of file
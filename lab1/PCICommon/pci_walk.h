@@ -0,0 +1,58 @@
+#pragma once
+#include "pci_config.h"
+#include "pci_filter.h"
+#include "pci_caps.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef uint32_t (*PCI_READ_CONFIG)(void* context, uint8_t bus, uint8_t device, uint8_t function, uint16_t offset);
+typedef void (*PCI_READ_HEADER)(void* context, uint8_t bus, uint8_t device, uint8_t function, uint32_t* header);
+
+typedef struct _PCI_WALK_FUNCTION {
+    uint8_t Bus;
+    uint8_t Device;
+    uint8_t Function;
+    uint8_t HeaderType;
+    uint32_t IdDword;
+    uint32_t ClassDword;
+    uint32_t SubsystemDword;
+    uint8_t SecondaryBus;
+    uint8_t SubordinateBus;
+    uint8_t Virtual;
+    uint16_t PhysicalFunction;
+    const uint32_t* Header;
+} PCI_WALK_FUNCTION, * PPCI_WALK_FUNCTION;
+
+typedef int (*PCI_VISIT_FUNCTION)(void* context, const PCI_WALK_FUNCTION* function);
+
+typedef struct _PCI_WALK_OPS {
+    PCI_READ_CONFIG ReadConfig;
+    PCI_READ_HEADER ReadHeader;
+    PCI_VISIT_FUNCTION Visit;
+    void* Context;
+    const uint8_t* RootBuses;
+    uint32_t RootBusCount;
+    const PCI_FILTER* Filter;
+    uint16_t ConfigSize;
+} PCI_WALK_OPS, * PPCI_WALK_OPS;
+
+typedef struct _PCI_WALK_STATS {
+    uint32_t ConfigReads;
+    uint32_t FunctionsFound;
+    uint32_t BusesScanned;
+    uint32_t VirtualFunctions;
+} PCI_WALK_STATS, * PPCI_WALK_STATS;
+
+typedef enum _PCI_WALK_RESULT {
+    PCI_WALK_COMPLETED = 0,
+    PCI_WALK_STOPPED = 1,
+    PCI_WALK_INVALID_ARGS = 2
+} PCI_WALK_RESULT;
+
+PCI_WALK_RESULT PciWalkTopology(const PCI_WALK_OPS* ops, PCI_WALK_STATS* stats);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
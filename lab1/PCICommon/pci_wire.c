@@ -0,0 +1,99 @@
+#include "pci_wire.h"
+
+typedef char PciWireHeaderSizeCheck[sizeof(PCI_WIRE_HEADER) == 24 ? 1 : -1];
+typedef char PciWireRecordSizeCheck[sizeof(PCI_WIRE_RECORD) == 20 ? 1 : -1];
+
+uint32_t PciWireBufferSize(uint32_t recordCount, uint16_t configSize) {
+    return (uint32_t)sizeof(PCI_WIRE_HEADER) + recordCount * ((uint32_t)sizeof(PCI_WIRE_RECORD) + configSize);
+}
+
+//    ( )     
+void PciWireBegin(void* buffer, uint16_t configSize) {
+    PPCI_WIRE_HEADER header = (PPCI_WIRE_HEADER)buffer;
+
+    header->Magic = PCI_WIRE_MAGIC;
+    header->Version = PCI_WIRE_VERSION;
+    header->RecordSize = (uint16_t)(sizeof(PCI_WIRE_RECORD) + configSize);
+    header->RecordCount = 0;
+    header->TotalCount = 0;
+    header->ConfigSize = configSize;
+    header->Flags = configSize ? PCI_WIRE_FLAG_CONFIG : 0;
+    header->Reserved = 0;
+}
+
+//       ,    TotalCount  -
+//        .
+//        NULL
+uint8_t* PciWireAppend(void* buffer, uint32_t bufferSize, const PCI_WIRE_RECORD* record) {
+    PPCI_WIRE_HEADER header = (PPCI_WIRE_HEADER)buffer;
+    uint8_t* slot;
+
+    header->TotalCount++;
+    if (header->RecordCount != header->TotalCount - 1 ||
+        PciWireBufferSize(header->RecordCount + 1, header->ConfigSize) > bufferSize) {
+        return 0;
+    }
+
+    slot = (uint8_t*)(header + 1) + header->RecordCount * header->RecordSize;
+    *(PPCI_WIRE_RECORD)slot = *record;
+    header->RecordCount++;
+
+    return slot + sizeof(PCI_WIRE_RECORD);
+}
+
+uint32_t PciWireUsedSize(const void* buffer) {
+    const PCI_WIRE_HEADER* header = (const PCI_WIRE_HEADER*)buffer;
+    return (uint32_t)sizeof(PCI_WIRE_HEADER) + header->RecordCount * header->RecordSize;
+}
+
+//           
+PCI_WIRE_STATUS PciWireValidate(const void* buffer, uint32_t size) {
+    const PCI_WIRE_HEADER* header = (const PCI_WIRE_HEADER*)buffer;
+
+    if (size < sizeof(PCI_WIRE_HEADER)) {
+        return PCI_WIRE_TRUNCATED;
+    }
+    if (header->Magic != PCI_WIRE_MAGIC) {
+        return PCI_WIRE_BAD_MAGIC;
+    }
+    if (header->Version != PCI_WIRE_VERSION) {
+        return PCI_WIRE_BAD_VERSION;
+    }
+    if (header->RecordSize < sizeof(PCI_WIRE_RECORD) + header->ConfigSize) {
+        return PCI_WIRE_BAD_RECORD_SIZE;
+    }
+    if ((uint64_t)header->RecordCount * header->RecordSize > size - sizeof(PCI_WIRE_HEADER)) {
+        return PCI_WIRE_TRUNCATED;
+    }
+
+    return PCI_WIRE_OK;
+}
+
+const PCI_WIRE_RECORD* PciWireRecordAt(const void* buffer, uint32_t index) {
+    const PCI_WIRE_HEADER* header = (const PCI_WIRE_HEADER*)buffer;
+    return (const PCI_WIRE_RECORD*)((const uint8_t*)(header + 1) + (uint64_t)index * header->RecordSize);
+}
+
+const uint8_t* PciWireRecordConfig(const void* buffer, uint32_t index) {
+    const PCI_WIRE_HEADER* header = (const PCI_WIRE_HEADER*)buffer;
+    return (const uint8_t*)PciWireRecordAt(buffer, index) + header->RecordSize - header->ConfigSize;
+}
+
+//       
+void PciWireFillRecord(PCI_WIRE_RECORD* record, const PCI_WALK_FUNCTION* function) {
+    record->Bus = function->Bus;
+    record->Device = function->Device;
+    record->Function = function->Function;
+    record->HeaderType = function->HeaderType;
+    record->VendorID = PCI_ID_VENDOR(function->IdDword);
+    record->DeviceID = PCI_ID_DEVICE(function->IdDword);
+    record->Revision = PCI_CLASS_REVISION(function->ClassDword);
+    record->ProgIF = PCI_CLASS_PROG_IF(function->ClassDword);
+    record->SubClass = PCI_CLASS_SUB(function->ClassDword);
+    record->BaseClass = PCI_CLASS_BASE(function->ClassDword);
+    record->SubsystemVendorID = PCI_ID_VENDOR(function->SubsystemDword);
+    record->SubsystemID = PCI_ID_DEVICE(function->SubsystemDword);
+    record->PhysicalFunction = function->PhysicalFunction;
+    record->Flags = function->Virtual ? PCI_WIRE_RECORD_VIRTUAL : 0;
+    record->Reserved = 0;
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include <stdint.h>
+#include "pci_walk.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PCI_WIRE_MAGIC    0x53494350u
+#define PCI_WIRE_VERSION  3
+
+#define PCI_WIRE_FLAG_CONFIG  0x0001
+#define PCI_WIRE_FLAG_FILTER  0x0002
+
+#define PCI_WIRE_RECORD_VIRTUAL  0x01
+
+#ifdef CTL_CODE
+#define IOCTL_PCI_GET_DEVICES CTL_CODE(FILE_DEVICE_UNKNOWN, 0x801, METHOD_BUFFERED, FILE_ANY_ACCESS)
+#endif
+
+#pragma pack(push, 1)
+
+typedef struct _PCI_WIRE_HEADER {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t RecordSize;
+    uint32_t RecordCount;
+    uint32_t TotalCount;
+    uint16_t ConfigSize;
+    uint16_t Flags;
+    uint32_t Reserved;
+} PCI_WIRE_HEADER, * PPCI_WIRE_HEADER;
+
+typedef struct _PCI_WIRE_REQUEST {
+    uint16_t Version;
+    uint16_t Flags;
+    uint16_t ConfigSize;
+    uint16_t Reserved;
+} PCI_WIRE_REQUEST, * PPCI_WIRE_REQUEST;
+
+typedef struct _PCI_WIRE_RECORD {
+    uint8_t Bus;
+    uint8_t Device;
+    uint8_t Function;
+    uint8_t HeaderType;
+    uint16_t VendorID;
+    uint16_t DeviceID;
+    uint8_t Revision;
+    uint8_t ProgIF;
+    uint8_t SubClass;
+    uint8_t BaseClass;
+    uint16_t SubsystemVendorID;
+    uint16_t SubsystemID;
+    uint16_t PhysicalFunction;
+    uint8_t Flags;
+    uint8_t Reserved;
+} PCI_WIRE_RECORD, * PPCI_WIRE_RECORD;
+
+#pragma pack(pop)
+
+typedef enum _PCI_WIRE_STATUS {
+    PCI_WIRE_OK = 0,
+    PCI_WIRE_TRUNCATED = 1,
+    PCI_WIRE_BAD_MAGIC = 2,
+    PCI_WIRE_BAD_VERSION = 3,
+    PCI_WIRE_BAD_RECORD_SIZE = 4
+} PCI_WIRE_STATUS;
+
+uint32_t PciWireBufferSize(uint32_t recordCount, uint16_t configSize);
+void PciWireBegin(void* buffer, uint16_t configSize);
+uint8_t* PciWireAppend(void* buffer, uint32_t bufferSize, const PCI_WIRE_RECORD* record);
+uint32_t PciWireUsedSize(const void* buffer);
+PCI_WIRE_STATUS PciWireValidate(const void* buffer, uint32_t size);
+const PCI_WIRE_RECORD* PciWireRecordAt(const void* buffer, uint32_t index);
+const uint8_t* PciWireRecordConfig(const void* buffer, uint32_t index);
+void PciWireFillRecord(PCI_WIRE_RECORD* record, const PCI_WALK_FUNCTION* function);
+
+#ifdef __cplusplus
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,142 @@
+#include "aer_sampler.h"
+#include <bit>
+#include <chrono>
+
+//     ;     
+Aer_Sample_Ring::Aer_Sample_Ring(size_t capacity)
+    : m_samples(capacity ? capacity : 1) {
+}
+
+void Aer_Sample_Ring::Push(const AER_SAMPLE& sample) {
+    m_samples[m_head] = sample;
+    m_head = (m_head + 1) % m_samples.size();
+    if (m_count < m_samples.size()) {
+        ++m_count;
+    }
+}
+
+//  0 -     
+const AER_SAMPLE& Aer_Sample_Ring::At(size_t index) const {
+    size_t first = (m_head + m_samples.size() - m_count) % m_samples.size();
+    return m_samples[(first + index) % m_samples.size()];
+}
+
+Aer_Sampler::Aer_Sampler(PCI_Backend& backend, size_t capacity)
+    : m_backend(backend),
+    m_capacity(capacity) {
+}
+
+void Aer_Sampler::AddDevice(const PCI_DEVICE_INFO& device) {
+    CHANNEL channel{ device, Aer_Sample_Ring(m_capacity), true, false };
+    channel.Device.Config = nullptr;
+    channel.Device.ConfigSize = 0;
+    m_channels.push_back(std::move(channel));
+}
+
+//  :    .   AER    .
+//     :      
+size_t Aer_Sampler::Sample() {
+    size_t sampled = 0;
+    for (auto& channel : m_channels) {
+        if (!channel.Supported) {
+            continue;
+        }
+
+        AER_SAMPLE sample;
+        if (!m_backend.ReadAerCounters(channel.Device, sample.Counters)) {
+            channel.Supported = channel.Ring.Size() > 0;
+            continue;
+        }
+        if (channel.Ring.Size() > 0 && sample.Counters.StatusOnly != channel.StatusOnly) {
+            channel.Ring.Clear();
+        }
+        channel.StatusOnly = sample.Counters.StatusOnly;
+        sample.TimestampNs = GetTimestampNs();
+        channel.Ring.Push(sample);
+        ++sampled;
+    }
+    return sampled;
+}
+
+//     ;      
+bool Aer_Sampler::GetLastRate(size_t channel, AER_RATE& rate) const {
+    const Aer_Sample_Ring& ring = m_channels[channel].Ring;
+    if (ring.Size() < 2 || m_channels[channel].StatusOnly) {
+        return false;
+    }
+    rate = ComputeRate(ring.At(ring.Size() - 2), ring.Newest());
+    return true;
+}
+
+//      
+bool Aer_Sampler::GetWindowRate(size_t channel, AER_RATE& rate) const {
+    const Aer_Sample_Ring& ring = m_channels[channel].Ring;
+    if (ring.Size() < 2 || m_channels[channel].StatusOnly) {
+        return false;
+    }
+    rate = ComputeRate(ring.Oldest(), ring.Newest());
+    return true;
+}
+
+//  ,     
+bool Aer_Sampler::GetLastLatched(size_t channel, AER_LATCHED& latched) const {
+    const Aer_Sample_Ring& ring = m_channels[channel].Ring;
+    if (ring.Size() < 2 || !m_channels[channel].StatusOnly) {
+        return false;
+    }
+    latched = ComputeLatched(ring.At(ring.Size() - 2), ring.Newest());
+    return true;
+}
+
+//    : ,    ,   
+bool Aer_Sampler::GetWindowLatched(size_t channel, AER_LATCHED& latched) const {
+    const Aer_Sample_Ring& ring = m_channels[channel].Ring;
+    if (ring.Size() < 2 || !m_channels[channel].StatusOnly) {
+        return false;
+    }
+
+    latched = {};
+    for (size_t i = 1; i < ring.Size(); ++i) {
+        AER_LATCHED step = ComputeLatched(ring.At(i - 1), ring.At(i));
+        latched.Correctable += step.Correctable;
+        latched.NonFatal += step.NonFatal;
+        latched.Fatal += step.Fatal;
+    }
+    return true;
+}
+
+//    ( ,  ) -    
+AER_RATE Aer_Sampler::ComputeRate(const AER_SAMPLE& from, const AER_SAMPLE& to) {
+    auto delta = [](uint64_t before, uint64_t after) {
+        return after > before ? static_cast<double>(after - before) : 0.0;
+    };
+
+    AER_RATE rate{};
+    rate.Seconds = static_cast<double>(to.TimestampNs - from.TimestampNs) / 1e9;
+    if (rate.Seconds <= 0) {
+        return rate;
+    }
+    rate.Correctable = delta(from.Counters.Correctable, to.Counters.Correctable) / rate.Seconds;
+    rate.NonFatal = delta(from.Counters.NonFatal, to.Counters.NonFatal) / rate.Seconds;
+    rate.Fatal = delta(from.Counters.Fatal, to.Counters.Fatal) / rate.Seconds;
+    return rate;
+}
+
+// ,    ,   :    ,
+//         
+AER_LATCHED Aer_Sampler::ComputeLatched(const AER_SAMPLE& from, const AER_SAMPLE& to) {
+    auto latched = [](uint64_t before, uint64_t after) {
+        return static_cast<unsigned>(std::popcount(after & ~before));
+    };
+
+    AER_LATCHED result{};
+    result.Correctable = latched(from.Counters.Correctable, to.Counters.Correctable);
+    result.NonFatal = latched(from.Counters.NonFatal, to.Counters.NonFatal);
+    result.Fatal = latched(from.Counters.Fatal, to.Counters.Fatal);
+    return result;
+}
+
+uint64_t Aer_Sampler::GetTimestampNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pci_backend.h"
+#include "pci_device_info.h"
+
+struct AER_SAMPLE {
+    uint64_t TimestampNs;
+    PCI_AER_COUNTERS Counters;
+};
+
+struct AER_RATE {
+    double Correctable;
+    double NonFatal;
+    double Fatal;
+    double Seconds;
+};
+
+struct AER_LATCHED {
+    unsigned Correctable;
+    unsigned NonFatal;
+    unsigned Fatal;
+};
+
+class Aer_Sample_Ring {
+private:
+    std::vector<AER_SAMPLE> m_samples;
+    size_t m_head{ 0 };
+    size_t m_count{ 0 };
+
+public:
+    explicit Aer_Sample_Ring(size_t capacity);
+
+    void Push(const AER_SAMPLE& sample);
+    size_t Size() const { return m_count; }
+    size_t Capacity() const { return m_samples.size(); }
+    const AER_SAMPLE& At(size_t index) const;
+    const AER_SAMPLE& Oldest() const { return At(0); }
+    const AER_SAMPLE& Newest() const { return At(m_count - 1); }
+    void Clear() { m_head = 0; m_count = 0; }
+};
+
+class Aer_Sampler {
+private:
+    struct CHANNEL {
+        PCI_DEVICE_INFO Device;
+        Aer_Sample_Ring Ring;
+        bool Supported;
+        bool StatusOnly;
+    };
+
+    PCI_Backend& m_backend;
+    size_t m_capacity;
+    std::vector<CHANNEL> m_channels;
+
+public:
+    static constexpr size_t DefaultCapacity = 256;
+
+    explicit Aer_Sampler(PCI_Backend& backend, size_t capacity = DefaultCapacity);
+
+    void AddDevice(const PCI_DEVICE_INFO& device);
+    size_t Sample();
+
+    size_t GetChannelCount() const { return m_channels.size(); }
+    const PCI_DEVICE_INFO& GetDevice(size_t channel) const { return m_channels[channel].Device; }
+    bool IsSupported(size_t channel) const { return m_channels[channel].Supported; }
+    bool IsStatusOnly(size_t channel) const { return m_channels[channel].StatusOnly; }
+    const Aer_Sample_Ring& GetSamples(size_t channel) const { return m_channels[channel].Ring; }
+    bool GetLastRate(size_t channel, AER_RATE& rate) const;
+    bool GetWindowRate(size_t channel, AER_RATE& rate) const;
+    bool GetLastLatched(size_t channel, AER_LATCHED& latched) const;
+    bool GetWindowLatched(size_t channel, AER_LATCHED& latched) const;
+
+private:
+    static AER_RATE ComputeRate(const AER_SAMPLE& from, const AER_SAMPLE& to);
+    static AER_LATCHED ComputeLatched(const AER_SAMPLE& from, const AER_SAMPLE& to);
+    static uint64_t GetTimestampNs();
+};
\ No newline at end of file
@@ -1,40 +1,217 @@
 #include "app.h"
 #include "pci_scanner.h"
 #include "console_formatter.h"
+#include "snapshot_backend.h"
+#include "scan_benchmark.h"
+#include "pci_inventory.h"
+#include "fleet_diff.h"
+#include "ring_backend.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#ifdef _WIN32
+#include <windows.h>
+#include "driver_backend.h"
+#else
+#include <cerrno>
+#include <unistd.h>
+#include "sysfs_backend.h"
+#endif
 
-int Application::Run() {
+static constexpr const char* DefaultIdsPath = "pci_ids.bin";
+
+//      
+static unsigned long GetSystemErrorCode() {
+#ifdef _WIN32
+    return GetLastError();
+#else
+    return static_cast<unsigned long>(errno);
+#endif
+}
+
+//      
+static std::string GetHostName() {
+    char name[256] = {};
+#ifdef _WIN32
+    DWORD size = sizeof(name);
+    if (!GetComputerNameA(name, &size)) {
+        return {};
+    }
+#else
+    if (gethostname(name, sizeof(name) - 1) != 0) {
+        return {};
+    }
+#endif
+    return name;
+}
+
+int Application::Run(int argc, char* argv[]) {
     SetupConsole();
 
-    Console_Formatter::PrintHeader();
+    std::string parseErr;
+    auto options = CommandLineParser::Parse(argc, argv, parseErr);
+    if (!options) {
+        Console_Formatter::PrintHeader();
+        std::cerr << "Error: " << parseErr << "\n";
+        return 1;
+    }
+
+    if (options->benchSysfsRoot) {
+        Console_Formatter::PrintHeader();
+        return RunBenchmark(*options);
+    }
+    if (options->benchTopology) {
+        Console_Formatter::PrintHeader();
+        return RunTopologyBenchmark(*options);
+    }
+    if (options->diffBase) {
+        Console_Formatter::PrintHeader();
+        return RunFleetDiff(*options);
+    }
+
+    //        stdout   :
+    //     stderr,       
+    OUTPUT_FORMAT format = GetOutputFormat(*options);
+    bool interactive = format == OUTPUT_FORMAT::Table && !options->watchInterval &&
+        !options->aerInterval && !options->benchAerTicks;
+    std::ostream& log = interactive ? std::cout : std::clog;
+
+    if (interactive) {
+        Console_Formatter::PrintHeader();
+    }
 
     try {
-        PCI_Scanner_App scanner;
+        //  --stats  ,        
+        std::unique_ptr<Scan_Stats> stats;
+        if (options->stats || options->statsPath) {
+            stats = std::make_unique<Scan_Stats>();
+        }
 
-        std::cout << "Initializing PCI scanner... ";
+        PCI_Scanner_App scanner(CreateBackend(*options));
+        scanner.SetStats(stats.get());
+        //        BAR    
+        bool resources = options->bars || options->lookupAddress;
+        scanner.SetConfigCapture(options->capabilities || options->inventoryPath || resources || options->links || options->audit);
+        LoadNames(scanner, *options);
+
+        log << "Initializing PCI scanner (" << scanner.GetBackend().GetName() << ")... ";
         if (!scanner.Initialize()) {
-            DWORD error = GetLastError();
-            std::cout << "FAILED\n\n";
-            ShowError(error);
-            WaitForExit();
+            unsigned long error = GetSystemErrorCode();
+            log << "FAILED\n\n";
+            ShowError(scanner.GetBackend(), error);
+            if (interactive) {
+                WaitForExit();
+            }
             return 1;
         }
-        std::cout << "SUCCESS\n\n";
+        log << "SUCCESS\n\n";
 
-        // 
-        std::cout << "Scanning PCI bus... ";
-        auto devices = scanner.Scan();
-        std::cout << "COMPLETED\n\n";
+        //    
+        if (options->recordPath) {
+            log << "Recording config-space snapshot... ";
+            Snapshot_Backend::Record(scanner.GetBackend(), *options->recordPath);
+            log << "COMPLETED\n\n";
+        }
+
+        if (options->watchInterval) {
+            Watch(scanner, *options, format);
+            return 0;
+        }
+        if (options->aerInterval || options->benchAerTicks) {
+            SampleAer(scanner, *options);
+            return 0;
+        }
+
+        // ;   --deadline  ,   
+        PCI_SCAN_OPTIONS scanOptions;
+        scanOptions.Filter = options->filter;
+        if (options->deadline) {
+            scanOptions.Deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(options->deadline);
+        }
+
+        log << "Scanning PCI bus... ";
+        std::vector<PCI_DEVICE_INFO> devices;
+        PCI_SCAN_STATUS status = scanner.Scan(scanOptions, [&](PCI_DEVICE_INFO& device) {
+            devices.push_back(std::move(device));
+            return true;
+        });
+        log << (status == PCI_SCAN_STATUS::Completed ? "COMPLETED\n\n" : "DEADLINE EXCEEDED, results are partial\n\n");
 
         //  
-        Console_Formatter::PrintDevices(devices);
-        Console_Formatter::PrintStatistics(devices);
+        {
+            Scan_Phase_Timer timer(stats.get(), SCAN_PHASE::Format);
+            Console_Formatter::PrintDevices(devices, format);
+        }
+        if (stats) {
+            ReportStats(stats->Collect(), *options, interactive);
+        }
+
+        const PCI_Device_Index& index = scanner.BuildIndex(devices);
+
+        if (interactive) {
+            Console_Formatter::PrintStatistics(index);
+
+            if (options->capabilities) {
+                Console_Formatter::PrintCapabilities(devices);
+            }
+
+            if (options->tree || options->pathKey) {
+                const PCI_Topology& topology = scanner.BuildTopology(devices);
+                if (options->tree) {
+                    Console_Formatter::PrintTopology(devices, topology);
+                }
+                if (options->pathKey) {
+                    uint32_t found = index.Find(*options->pathKey);
+                    if (found == PCI_Device_Index::None) {
+                        std::cout << "\nDevice for --path not found\n";
+                    }
+                    else {
+                        Console_Formatter::PrintDevicePath(devices, topology, found);
+                    }
+                }
+            }
+
+            if (resources) {
+                const PCI_Resource_Map& map = scanner.BuildResourceMap(devices);
+                if (options->bars) {
+                    Console_Formatter::PrintResourceMap(map, scanner.GetIoPortMap());
+                }
+                if (options->lookupAddress) {
+                    Console_Formatter::PrintAddressLookup(*options->lookupAddress, scanner.LookupAddress(*options->lookupAddress));
+                }
+            }
 
+            if (options->links) {
+                Console_Formatter::PrintLinkReport(devices, scanner.AnalyzeLinks(devices));
+            }
+
+            if (options->audit) {
+                Console_Formatter::PrintTuningAudit(devices, scanner.AuditTuning(devices));
+            }
+
+            if (options->locality) {
+                auto entries = scanner.BuildLocalityReport(devices, options->interruptsPath.value_or(Proc_Interrupts::DefaultPath));
+                Console_Formatter::PrintLocalityReport(devices, entries);
+            }
+        }
+
+        if (options->inventoryPath) {
+            PCI_Inventory::Save(devices, index, *options->inventoryPath, GetHostName());
+            log << "\nInventory saved to " << *options->inventoryPath << "\n";
+        }
+
+        if (!interactive) {
+            return 0;
+        }
         std::cout << "\nOperation completed successfully!\n";
 
     }
     catch (const std::exception& ex) {
         std::cerr << "\nError: " << ex.what() << "\n";
-        WaitForExit();
+        if (interactive) {
+            WaitForExit();
+        }
         return 1;
     }
 
@@ -42,19 +219,245 @@ int Application::Run() {
     return 0;
 }
 
+//     ;    stdout 
+// ,     stderr    JSON,   --stats-json
+void Application::ReportStats(const SCAN_STATS_SUMMARY& stats, const CmdOptions& options, bool interactive) {
+    std::string json;
+    if (options.stats && interactive) {
+        Console_Formatter::PrintScanStats(stats);
+    }
+    else if (options.stats) {
+        Console_Formatter::FormatScanStatsJson(stats, json);
+        std::clog << json;
+    }
+
+    if (options.statsPath) {
+        Console_Formatter::FormatScanStatsJson(stats, json);
+        std::ofstream out(*options.statsPath, std::ios::trunc);
+        if (!out || !(out << json)) {
+            throw std::runtime_error("Cannot write scan statistics to " + *options.statsPath);
+        }
+    }
+}
+
+//   - ,    .  
+//    ,      
+void Application::Watch(PCI_Scanner_App& scanner, const CmdOptions& options, OUTPUT_FORMAT format) {
+    auto devices = scanner.Scan(options.filter);
+    std::clog << "Watching " << devices.size() << " functions every " << options.watchInterval << " ms\n";
+
+    if (format == OUTPUT_FORMAT::Csv) {
+        std::cout << "event,generation," << Console_Formatter::GetCsvColumns() << "\n" << std::flush;
+    }
+
+    auto interval = std::chrono::milliseconds(options.watchInterval);
+    auto next = std::chrono::steady_clock::now() + interval;
+
+    for (unsigned i = 0; options.watchCount == 0 || i < options.watchCount; ++i) {
+        std::this_thread::sleep_until(next);
+        next += interval;
+
+        PCI_SCAN_DELTA delta = scanner.ScanDelta();
+        if (!delta.IsEmpty()) {
+            Console_Formatter::PrintDelta(delta, format);
+        }
+    }
+}
+
+//   AER      .
+//     ,     
+void Application::SampleAer(PCI_Scanner_App& scanner, const CmdOptions& options) {
+    auto devices = scanner.Scan(options.filter);
+    Aer_Sampler sampler(scanner.GetBackend());
+    for (const auto& device : devices) {
+        sampler.AddDevice(device);
+    }
+
+    if (options.benchAerTicks) {
+        Console_Formatter::PrintAerBenchmark(Scan_Benchmark::RunAer(sampler, options.benchAerTicks));
+        return;
+    }
+
+    std::clog << "Sampling AER counters of " << devices.size() << " functions every " << options.aerInterval << " ms\n";
+
+    auto interval = std::chrono::milliseconds(options.aerInterval);
+    auto next = std::chrono::steady_clock::now();
+
+    for (unsigned i = 0; options.aerTicks == 0 || i < options.aerTicks; ++i) {
+        std::this_thread::sleep_until(next);
+        next += interval;
+
+        sampler.Sample();
+        Console_Formatter::PrintAerTick(sampler, i);
+    }
+
+    Console_Formatter::PrintAerSummary(sampler);
+}
+
+OUTPUT_FORMAT Application::GetOutputFormat(const CmdOptions& options) {
+    if (options.format == "json") {
+        return OUTPUT_FORMAT::JsonLines;
+    }
+    if (options.format == "csv") {
+        return OUTPUT_FORMAT::Csv;
+    }
+    return OUTPUT_FORMAT::Table;
+}
+
+//   sysfs      
+int Application::RunBenchmark(const CmdOptions& options) {
+    constexpr unsigned iterations = 20;
+
+    try {
+        unsigned maxThreads = options.threads ? options.threads : std::max(1u, std::thread::hardware_concurrency());
+
+        std::cout << "Generating " << options.benchFunctions << " functions in " << *options.benchSysfsRoot << "... ";
+        Scan_Benchmark::GenerateSysfsTree(*options.benchSysfsRoot, options.benchFunctions);
+        std::cout << "COMPLETED\n\n";
+
+        Console_Formatter::PrintBenchmark(Scan_Benchmark::RunSysfs(*options.benchSysfsRoot, iterations, maxThreads));
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "\nError: " << ex.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+//        
+int Application::RunTopologyBenchmark(const CmdOptions& options) {
+    SYNTHETIC_TOPOLOGY_PARAMS params;
+    std::string err;
+    if (!Synthetic_Topology::ParseParams(*options.benchTopology, params, err)) {
+        std::cerr << "Error: " << err << "\n";
+        return 1;
+    }
+
+    try {
+        Synthetic_Topology topology(params);
+        Console_Formatter::PrintTopologyBenchmark(topology.GetStats(), params.LatencyNs,
+            Scan_Benchmark::RunTopology(topology, params.Iterations));
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "\nError: " << ex.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+//         
+int Application::RunFleetDiff(const CmdOptions& options) {
+    try {
+        PCI_Inventory base;
+        if (!base.Open(*options.diffBase)) {
+            throw std::runtime_error("Invalid inventory snapshot: " + *options.diffBase);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto results = Fleet_Diff::Run(base, Fleet_Diff::ListInventories(*options.diffTarget), options.threads);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        Console_Formatter::PrintFleetDiff(results);
+        std::cout << std::format("Compared in {:.1f} ms\n", elapsed.count());
+
+        bool different = std::any_of(results.begin(), results.end(), [](const FLEET_DIFF_RESULT& result) {
+            return !result.Valid || !result.Changes.empty();
+        });
+        return different ? 2 : 0;
+    }
+    catch (const std::exception& ex) {
+        std::cerr << "\nError: " << ex.what() << "\n";
+        return 1;
+    }
+}
+
+//  pci.ids ( )    .
+//  --ids  pci_ids.bin   ;    
+void Application::LoadNames(PCI_Scanner_App& scanner, const CmdOptions& options) {
+    if (options.compileIdsPath) {
+        std::string err;
+        std::cout << "Compiling " << *options.compileIdsPath << "... ";
+        if (!PCI_Ids_Database::Compile(*options.compileIdsPath, *options.idsPath, err)) {
+            throw std::runtime_error(err);
+        }
+        std::cout << "COMPLETED\n\n";
+    }
+
+    if (options.idsPath) {
+        if (!scanner.LoadNameDatabase(*options.idsPath)) {
+            throw std::runtime_error("Invalid name database: " + *options.idsPath);
+        }
+    }
+    else {
+        scanner.LoadNameDatabase(DefaultIdsPath);
+    }
+}
+
+//    
+std::unique_ptr<PCI_Backend> Application::CreateBackend(const CmdOptions& options) {
+    if (options.backend == "snapshot") {
+        return std::make_unique<Snapshot_Backend>(*options.snapshotPath);
+    }
+    //      user space -     
+    if (options.ringTopology) {
+        SYNTHETIC_TOPOLOGY_PARAMS params;
+        std::string err;
+        if (!Synthetic_Topology::ParseParams(*options.ringTopology, params, err)) {
+            throw std::runtime_error(err);
+        }
+        return std::make_unique<Synthetic_Ring_Backend>(params);
+    }
+#ifdef _WIN32
+    if (options.backend == "sysfs") {
+        throw std::runtime_error("sysfs backend is only available on Linux");
+    }
+    if (options.backend == "ring") {
+        return std::make_unique<Driver_Ring_Backend>();
+    }
+#else
+    if (options.backend == "ring") {
+        throw std::runtime_error("ring backend needs the driver on this platform; use --ring-topology <spec>");
+    }
+    if (options.backend == "driver") {
+        throw std::runtime_error("driver backend is only available on Windows");
+    }
+    if (options.sysfsRoot || options.threads) {
+        return std::make_unique<Sysfs_Backend>(options.sysfsRoot.value_or(Sysfs_Backend::DefaultRoot), options.threads);
+    }
+#endif
+    return PCI_Backend::CreateDefault();
+}
+
 void Application::SetupConsole() {
+#ifdef _WIN32
     SetConsoleOutputCP(CP_UTF8);
     SetConsoleCP(CP_UTF8);
     SetConsoleTitleW(L"PCI Device Scanner - C++");
+#endif
 }
 
-void Application::ShowError(DWORD errorCode) {
-    std::cerr << "Cannot access PCI scanner driver.\n";
+void Application::ShowError(const PCI_Backend& backend, unsigned long errorCode) {
+    std::cerr << "Cannot access PCI " << backend.GetName() << " backend.\n";
     std::cerr << "Error code: " << errorCode << "\n\n";
     std::cerr << "Some help:\n";
-    std::cerr << "1. sc create PCIScanner binPath= \"C:\\path\\pci_scanner.sys\" type= kernel\n";
-    std::cerr << "2. sc start PCIScanner\n";
-    std::cerr << "3. You have administrator privileges\n";
+
+    std::string name = backend.GetName();
+    if (name == "driver") {
+        std::cerr << "1. sc create PCIScanner binPath= \"C:\\path\\pci_scanner.sys\" type= kernel\n";
+        std::cerr << "2. sc start PCIScanner\n";
+        std::cerr << "3. You have administrator privileges\n";
+    }
+    else if (name == "sysfs") {
+        std::cerr << "1. sysfs is mounted and /sys/bus/pci/devices exists\n";
+        std::cerr << "2. --sysfs-root points to a directory of DDDD:BB:DD.F entries\n";
+    }
+    else if (name == "ring") {
+        std::cerr << "1. The loaded driver supports IOCTL_PCI_MAP_RING (update pci_scanner.sys)\n";
+        std::cerr << "2. You have administrator privileges\n";
+    }
+    else {
+        std::cerr << "1. The snapshot file exists and was written by --record\n";
+    }
 }
 
 void Application::WaitForExit() {
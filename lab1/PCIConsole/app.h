@@ -1,13 +1,28 @@
 #pragma once
-#include <windows.h>
 #include <iostream>
+#include <memory>
+#include "command_line.h"
+#include "pci_backend.h"
+#include "console_formatter.h"
+#include "scan_stats.h"
+
+class PCI_Scanner_App;
 
 class Application {
 public:
-    int Run();
+    int Run(int argc, char* argv[]);
 
 private:
+    static OUTPUT_FORMAT GetOutputFormat(const CmdOptions& options);
+    void Watch(PCI_Scanner_App& scanner, const CmdOptions& options, OUTPUT_FORMAT format);
+    void SampleAer(PCI_Scanner_App& scanner, const CmdOptions& options);
+    void ReportStats(const SCAN_STATS_SUMMARY& stats, const CmdOptions& options, bool interactive);
+    int RunBenchmark(const CmdOptions& options);
+    int RunTopologyBenchmark(const CmdOptions& options);
+    int RunFleetDiff(const CmdOptions& options);
+    std::unique_ptr<PCI_Backend> CreateBackend(const CmdOptions& options);
+    void LoadNames(PCI_Scanner_App& scanner, const CmdOptions& options);
     void SetupConsole();
-    void ShowError(DWORD errorCode);
+    void ShowError(const PCI_Backend& backend, unsigned long errorCode);
     void WaitForExit();
-}; 
+};
\ No newline at end of file
@@ -0,0 +1,272 @@
+#include "command_line.h"
+#include <cstdio>
+#include <cstdlib>
+
+//    
+std::optional<CmdOptions> CommandLineParser::Parse(int argc, char* argv[], std::string& err) {
+    CmdOptions opt;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+
+        //   ,  ,  
+        auto takeValue = [&](std::string& value) {
+            if (i + 1 >= argc) {
+                err = "Missing value for " + a;
+                return false;
+            }
+            value = argv[++i];
+            return true;
+        };
+
+        auto takeNumber = [&](unsigned& number) {
+            std::string text;
+            if (!takeValue(text)) {
+                return false;
+            }
+            char* end = nullptr;
+            unsigned long parsed = std::strtoul(text.c_str(), &end, 10);
+            if (text.empty() || *end != '\0' || parsed == 0 || parsed > 1000000) {
+                err = "Invalid number for " + a + ": " + text;
+                return false;
+            }
+            number = static_cast<unsigned>(parsed);
+            return true;
+        };
+
+        //     "02"  "8086"   limit
+        auto parseHex = [&](const std::string& text, unsigned limit, unsigned& number) {
+            char* end = nullptr;
+            unsigned long parsed = std::strtoul(text.c_str(), &end, 16);
+            if (text.empty() || *end != '\0' || parsed > limit) {
+                err = "Invalid value for " + a + ": " + text;
+                return false;
+            }
+            number = static_cast<unsigned>(parsed);
+            return true;
+        };
+
+        //  "first<sep>second",    
+        auto parsePair = [&](const std::string& text, char separator, unsigned limit, unsigned& first, std::optional<unsigned>& second) {
+            size_t split = text.find(separator);
+            if (!parseHex(text.substr(0, split), limit, first)) {
+                return false;
+            }
+            second.reset();
+            if (split != std::string::npos) {
+                unsigned number = 0;
+                if (!parseHex(text.substr(split + 1), limit, number)) {
+                    return false;
+                }
+                second = number;
+            }
+            return true;
+        };
+
+        std::string value;
+        unsigned first = 0;
+        std::optional<unsigned> second;
+        if (a == "--backend") {
+            if (!takeValue(value)) return std::nullopt;
+            if (value != "driver" && value != "sysfs" && value != "snapshot" && value != "ring") {
+                err = "Unknown backend: " + value + " (expected driver, sysfs, snapshot or ring)";
+                return std::nullopt;
+            }
+            opt.backend = value;
+        }
+        else if (a == "--format") {
+            if (!takeValue(value)) return std::nullopt;
+            if (value != "table" && value != "json" && value != "csv") {
+                err = "Unknown format: " + value + " (expected table, json or csv)";
+                return std::nullopt;
+            }
+            opt.format = value;
+        }
+        else if (a == "--snapshot") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.snapshotPath = value;
+        }
+        else if (a == "--sysfs-root") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.sysfsRoot = value;
+        }
+        else if (a == "--record") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.recordPath = value;
+        }
+        else if (a == "--ids") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.idsPath = value;
+        }
+        else if (a == "--compile-ids") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.compileIdsPath = value;
+        }
+        else if (a == "--save-inventory") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.inventoryPath = value;
+        }
+        else if (a == "--diff") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.diffBase = value;
+            if (!takeValue(value)) return std::nullopt;
+            opt.diffTarget = value;
+        }
+        else if (a == "--watch") {
+            if (!takeNumber(opt.watchInterval)) return std::nullopt;
+        }
+        else if (a == "--watch-count") {
+            if (!takeNumber(opt.watchCount)) return std::nullopt;
+        }
+        else if (a == "--aer") {
+            if (!takeNumber(opt.aerInterval)) return std::nullopt;
+        }
+        else if (a == "--aer-count") {
+            if (!takeNumber(opt.aerTicks)) return std::nullopt;
+        }
+        else if (a == "--bench-aer") {
+            if (!takeNumber(opt.benchAerTicks)) return std::nullopt;
+        }
+        else if (a == "--deadline") {
+            if (!takeNumber(opt.deadline)) return std::nullopt;
+        }
+        else if (a == "--threads") {
+            if (!takeNumber(opt.threads)) return std::nullopt;
+        }
+        else if (a == "--bench-sysfs") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.benchSysfsRoot = value;
+        }
+        else if (a == "--bench-topology") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.benchTopology = value;
+        }
+        else if (a == "--ring-topology") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.ringTopology = value;
+        }
+        else if (a == "--bench-functions") {
+            if (!takeNumber(opt.benchFunctions)) return std::nullopt;
+        }
+        else if (a == "--caps") {
+            opt.capabilities = true;
+        }
+        else if (a == "--class") {
+            if (!takeValue(value) || !parsePair(value, ':', 0xFF, first, second)) return std::nullopt;
+            opt.filter.Flags |= PCI_FILTER_CLASS;
+            opt.filter.ClassCode = static_cast<uint16_t>((first << 8) | second.value_or(0));
+            opt.filter.ClassMask = second ? 0xFFFF : 0xFF00;
+        }
+        else if (a == "--vendor") {
+            if (!takeValue(value) || !parsePair(value, ':', 0xFFFF, first, second)) return std::nullopt;
+            if (opt.filter.IdCount == PCI_FILTER_MAX_IDS) {
+                err = "Too many --vendor filters (at most " + std::to_string(PCI_FILTER_MAX_IDS) + ")";
+                return std::nullopt;
+            }
+            opt.filter.Flags |= PCI_FILTER_IDS;
+            opt.filter.Ids[opt.filter.IdCount++] = PCI_FILTER_ID(first, second.value_or(PCI_FILTER_ANY_DEVICE));
+        }
+        else if (a == "--bus") {
+            if (!takeValue(value) || !parsePair(value, '-', 0xFF, first, second)) return std::nullopt;
+            if (second.value_or(first) < first) {
+                err = "Invalid bus range: " + value;
+                return std::nullopt;
+            }
+            opt.filter.Flags |= PCI_FILTER_BUS_RANGE;
+            opt.filter.BusFirst = static_cast<uint8_t>(first);
+            opt.filter.BusLast = static_cast<uint8_t>(second.value_or(first));
+        }
+        else if (a == "--tree") {
+            opt.tree = true;
+        }
+        else if (a == "--path") {
+            if (!takeValue(value)) return std::nullopt;
+            //   ,   lspci: BB:DD.F  0000:BB:DD.F
+            unsigned segment = 0, bus = 0, device = 0, function = 0;
+            char tail = 0;
+            bool parsed = std::sscanf(value.c_str(), "%x:%x:%x.%x%c", &segment, &bus, &device, &function, &tail) == 4;
+            if (!parsed) {
+                segment = 0;
+                parsed = std::sscanf(value.c_str(), "%x:%x.%x%c", &bus, &device, &function, &tail) == 3;
+            }
+            if (!parsed || segment > UINT16_MAX ||
+                bus >= PCI_MAX_BUSES || device >= PCI_MAX_DEVICES || function >= PCI_MAX_FUNCTIONS) {
+                err = "Invalid address for --path: " + value + " (expected [DDDD:]BB:DD.F)";
+                return std::nullopt;
+            }
+            opt.pathKey = (segment << 16) | (bus << 8) | (device << 3) | function;
+        }
+        else if (a == "--links") {
+            opt.links = true;
+        }
+        else if (a == "--audit") {
+            opt.audit = true;
+        }
+        else if (a == "--locality") {
+            opt.locality = true;
+        }
+        else if (a == "--interrupts") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.interruptsPath = value;
+        }
+        else if (a == "--stats") {
+            opt.stats = true;
+        }
+        else if (a == "--stats-json") {
+            if (!takeValue(value)) return std::nullopt;
+            opt.statsPath = value;
+        }
+        else if (a == "--bars") {
+            opt.bars = true;
+        }
+        else if (a == "--lookup") {
+            if (!takeValue(value)) return std::nullopt;
+            char* end = nullptr;
+            unsigned long long address = std::strtoull(value.c_str(), &end, 16);
+            if (value.empty() || *end != '\0') {
+                err = "Invalid address for --lookup: " + value;
+                return std::nullopt;
+            }
+            opt.lookupAddress = address;
+        }
+        else {
+            err = "Unsupported argument: " + a;
+            return std::nullopt;
+        }
+    }
+
+    if (opt.backend.empty() && opt.snapshotPath) {
+        opt.backend = "snapshot";
+    }
+    if (opt.backend == "snapshot" && !opt.snapshotPath) {
+        err = "--backend snapshot requires --snapshot <file>";
+        return std::nullopt;
+    }
+    if (opt.snapshotPath && opt.backend != "snapshot") {
+        err = "--snapshot conflicts with --backend " + opt.backend;
+        return std::nullopt;
+    }
+    if (opt.backend.empty() && opt.ringTopology) {
+        opt.backend = "ring";
+    }
+    if (opt.ringTopology && opt.backend != "ring") {
+        err = "--ring-topology conflicts with --backend " + opt.backend;
+        return std::nullopt;
+    }
+    if (opt.watchCount && !opt.watchInterval) {
+        err = "--watch-count requires --watch <milliseconds>";
+        return std::nullopt;
+    }
+    if (opt.aerTicks && !opt.aerInterval) {
+        err = "--aer-count requires --aer <milliseconds>";
+        return std::nullopt;
+    }
+    if ((opt.stats || opt.statsPath) && (opt.watchInterval || opt.aerInterval || opt.benchAerTicks)) {
+        err = "--stats and --stats-json apply to a single scan, not to --watch or --aer";
+        return std::nullopt;
+    }
+    if (opt.compileIdsPath && !opt.idsPath) {
+        err = "--compile-ids requires --ids <output file>";
+        return std::nullopt;
+    }
+    return opt;
+}
\ No newline at end of file
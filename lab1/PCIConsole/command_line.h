@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <optional>
+#include "../PCICommon/pci_filter.h"
+
+struct CmdOptions {
+    std::string backend;
+    std::string format = "table";
+    std::optional<std::string> snapshotPath;
+    std::optional<std::string> sysfsRoot;
+    std::optional<std::string> recordPath;
+    std::optional<std::string> idsPath;
+    std::optional<std::string> compileIdsPath;
+    std::optional<std::string> inventoryPath;
+    std::optional<std::string> diffBase;
+    std::optional<std::string> diffTarget;
+    std::optional<std::string> benchSysfsRoot;
+    std::optional<std::string> benchTopology;
+    std::optional<std::string> ringTopology;
+    std::optional<std::string> interruptsPath;
+    std::optional<std::string> statsPath;
+    std::optional<uint64_t> lookupAddress;
+    std::optional<uint32_t> pathKey;
+    unsigned benchFunctions = 1024;
+    unsigned threads = 0;
+    unsigned watchInterval = 0;
+    unsigned watchCount = 0;
+    unsigned deadline = 0;
+    unsigned aerInterval = 0;
+    unsigned aerTicks = 0;
+    unsigned benchAerTicks = 0;
+    bool capabilities = false;
+    bool bars = false;
+    bool tree = false;
+    bool locality = false;
+    bool links = false;
+    bool audit = false;
+    bool stats = false;
+    PCI_FILTER filter{};
+};
+
+class CommandLineParser {
+public:
+    static std::optional<CmdOptions> Parse(int argc, char* argv[], std::string& err);
+};
\ No newline at end of file
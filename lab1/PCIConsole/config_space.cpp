@@ -0,0 +1,198 @@
+#include "config_space.h"
+#include <format>
+#include "pci_decoder.h"
+
+PCI_Config_Space::PCI_Config_Space(const uint8_t* data, uint16_t size)
+    : m_data(data), m_size(data ? size : 0) {
+}
+
+PCI_Config_Space::PCI_Config_Space(const PCI_DEVICE_INFO& device)
+    : PCI_Config_Space(device.Config, device.ConfigSize) {
+}
+
+bool PCI_Config_Space::IsExtended() const {
+    return m_size > PCI_CFG_SPACE_SIZE;
+}
+
+//          
+uint8_t PCI_Config_Space::Read8(uint16_t offset) const {
+    return offset < m_size ? m_data[offset] : 0xFF;
+}
+
+uint16_t PCI_Config_Space::Read16(uint16_t offset) const {
+    return offset + 2u <= m_size ? PCI_Config_Decoder::Read16(m_data, offset) : 0xFFFF;
+}
+
+uint32_t PCI_Config_Space::Read32(uint16_t offset) const {
+    return offset + 4u <= m_size ? PCI_Config_Decoder::Read32(m_data, offset) : 0xFFFFFFFF;
+}
+
+//      ,    
+std::vector<PCI_CAPABILITY> PCI_Config_Space::GetCapabilities() const {
+    std::vector<PCI_CAPABILITY> capabilities;
+    if (!IsValid()) {
+        return capabilities;
+    }
+
+    PCI_CAP_SOURCE source = GetSource();
+    PCI_CAP_CURSOR cursor;
+    PCI_CAPABILITY capability;
+
+    for (int found = PciCapFirst(&source, &cursor, &capability); found;
+        found = PciCapNext(&source, &cursor, &capability)) {
+        capabilities.push_back(capability);
+    }
+
+    return capabilities;
+}
+
+uint16_t PCI_Config_Space::FindCapability(uint8_t id) const {
+    if (!IsValid()) {
+        return 0;
+    }
+    PCI_CAP_SOURCE source = GetSource();
+    return PciCapFind(&source, id);
+}
+
+uint16_t PCI_Config_Space::FindExtendedCapability(uint16_t id) const {
+    if (!IsValid()) {
+        return 0;
+    }
+    PCI_CAP_SOURCE source = GetSource();
+    return PciExtCapFind(&source, id);
+}
+
+//       Link Status
+bool PCI_Config_Space::GetLinkStatus(uint8_t& speed, uint8_t& width) const {
+    uint16_t pcie = FindCapability(PCI_CAP_ID_EXP);
+    if (!pcie) {
+        return false;
+    }
+
+    uint16_t status = Read16(pcie + PCI_EXP_LNKSTA);
+    if (status == 0xFFFF || PCI_EXP_LNKSTA_WIDTH(status) == 0) {
+        return false;
+    }
+
+    speed = static_cast<uint8_t>(PCI_EXP_LNKSTA_SPEED(status));
+    width = static_cast<uint8_t>(PCI_EXP_LNKSTA_WIDTH(status));
+    return true;
+}
+
+// Link Capabilities  Link Status    :    
+//     ,   -    
+bool PCI_Config_Space::GetLink(PCI_LINK& link) const {
+    uint16_t pcie = FindCapability(PCI_CAP_ID_EXP);
+    if (!pcie) {
+        return false;
+    }
+
+    uint32_t capabilities = Read32(pcie + PCI_EXP_LNKCAP);
+    uint16_t status = Read16(pcie + PCI_EXP_LNKSTA);
+    if (capabilities == 0xFFFFFFFF || status == 0xFFFF || PCI_EXP_LNKSTA_WIDTH(status) == 0) {
+        return false;
+    }
+
+    link.PortType = PCI_EXP_FLAGS_TYPE(Read16(pcie + PCI_EXP_FLAGS));
+    link.MaxSpeed = PCI_EXP_LNKCAP_SPEED(capabilities);
+    link.MaxWidth = PCI_EXP_LNKCAP_WIDTH(capabilities);
+    link.Speed = PCI_EXP_LNKSTA_SPEED(status);
+    link.Width = PCI_EXP_LNKSTA_WIDTH(status);
+    return true;
+}
+
+//    Device Capabilities/Control  Link Capabilities/Control.
+//     :  -    128 
+bool PCI_Config_Space::GetTuning(PCI_LINK_TUNING& tuning) const {
+    uint16_t pcie = FindCapability(PCI_CAP_ID_EXP);
+    if (!pcie) {
+        return false;
+    }
+
+    uint32_t deviceCaps = Read32(pcie + PCI_EXP_DEVCAP);
+    uint16_t deviceControl = Read16(pcie + PCI_EXP_DEVCTL);
+    uint32_t linkCaps = Read32(pcie + PCI_EXP_LNKCAP);
+    uint16_t linkControl = Read16(pcie + PCI_EXP_LNKCTL);
+    if (deviceCaps == 0xFFFFFFFF || deviceControl == 0xFFFF) {
+        return false;
+    }
+
+    tuning.PortType = PCI_EXP_FLAGS_TYPE(Read16(pcie + PCI_EXP_FLAGS));
+    tuning.PayloadSupported = PCI_EXP_DEVCAP_PAYLOAD(deviceCaps);
+    tuning.Payload = PCI_EXP_DEVCTL_PAYLOAD(deviceControl);
+    tuning.ReadRequest = PCI_EXP_DEVCTL_READRQ(deviceControl);
+    tuning.RelaxedOrdering = (deviceControl & PCI_EXP_DEVCTL_RELAX_EN) != 0;
+    tuning.AspmSupported = PCI_EXP_LNKCAP_ASPMS(linkCaps);
+    tuning.AspmEnabled = PCI_EXP_LNKCTL_ASPMC(linkControl);
+    tuning.L0sExitLatency = PCI_EXP_LNKCAP_L0SEL(linkCaps);
+    tuning.L1ExitLatency = PCI_EXP_LNKCAP_L1EL(linkCaps);
+    tuning.L0sAcceptable = PCI_EXP_DEVCAP_L0S_ACC(deviceCaps);
+    tuning.L1Acceptable = PCI_EXP_DEVCAP_L1_ACC(deviceCaps);
+    return true;
+}
+
+bool PCI_Config_Space::GetSriov(PCI_SRIOV& sriov) const {
+    PCI_CAP_SOURCE source = GetSource();
+    return PciSriovRead(&source, FindExtendedCapability(PCI_EXT_CAP_ID_SRIOV), &sriov) != 0;
+}
+
+std::string PCI_Config_Space::DescribeLink() const {
+    uint8_t speed = 0, width = 0;
+    if (!GetLinkStatus(speed, width)) {
+        return {};
+    }
+    return std::format("x{} Gen{}", width, speed);
+}
+
+const char* PCI_Config_Space::GetCapabilityName(const PCI_CAPABILITY& capability) {
+    if (capability.Extended) {
+        switch (capability.Id) {
+        case PCI_EXT_CAP_ID_AER: return "Advanced Error Reporting";
+        case PCI_EXT_CAP_ID_VC: return "Virtual Channel";
+        case PCI_EXT_CAP_ID_DSN: return "Device Serial Number";
+        case PCI_EXT_CAP_ID_PWR: return "Power Budgeting";
+        case PCI_EXT_CAP_ID_VNDR: return "Vendor Specific";
+        case PCI_EXT_CAP_ID_ACS: return "Access Control Services";
+        case PCI_EXT_CAP_ID_ARI: return "Alternative Routing-ID";
+        case PCI_EXT_CAP_ID_ATS: return "Address Translation Services";
+        case PCI_EXT_CAP_ID_SRIOV: return "SR-IOV";
+        case PCI_EXT_CAP_ID_LTR: return "Latency Tolerance Reporting";
+        case PCI_EXT_CAP_ID_SECPCI: return "Secondary PCI Express";
+        case PCI_EXT_CAP_ID_PASID: return "PASID";
+        case PCI_EXT_CAP_ID_L1SS: return "L1 PM Substates";
+        case PCI_EXT_CAP_ID_DLF: return "Data Link Feature";
+        case PCI_EXT_CAP_ID_PL_16GT: return "Physical Layer 16.0 GT/s";
+        default: return "Unknown Extended";
+        }
+    }
+
+    switch (capability.Id) {
+    case PCI_CAP_ID_PM: return "Power Management";
+    case PCI_CAP_ID_AGP: return "AGP";
+    case PCI_CAP_ID_VPD: return "Vital Product Data";
+    case PCI_CAP_ID_SLOTID: return "Slot Identification";
+    case PCI_CAP_ID_MSI: return "MSI";
+    case PCI_CAP_ID_HT: return "HyperTransport";
+    case PCI_CAP_ID_VNDR: return "Vendor Specific";
+    case PCI_CAP_ID_DBG: return "Debug Port";
+    case PCI_CAP_ID_SSVID: return "Subsystem Vendor ID";
+    case PCI_CAP_ID_EXP: return "PCI Express";
+    case PCI_CAP_ID_MSIX: return "MSI-X";
+    case PCI_CAP_ID_SATA: return "SATA";
+    case PCI_CAP_ID_AF: return "Advanced Features";
+    case PCI_CAP_ID_EA: return "Enhanced Allocation";
+    default: return "Unknown";
+    }
+}
+
+PCI_CAP_SOURCE PCI_Config_Space::GetSource() const {
+    PCI_CAP_SOURCE source{};
+    source.Read = ReadCallback;
+    source.Context = const_cast<PCI_Config_Space*>(this);
+    source.ConfigSize = m_size;
+    return source;
+}
+
+uint32_t PCI_Config_Space::ReadCallback(void* context, uint16_t offset) {
+    return static_cast<const PCI_Config_Space*>(context)->Read32(offset);
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "pci_device_info.h"
+#include "pci_link.h"
+#include "../PCICommon/pci_caps.h"
+#include "../PCICommon/pci_sriov.h"
+
+class PCI_Config_Space {
+private:
+    const uint8_t* m_data{ nullptr };
+    uint16_t m_size{ 0 };
+
+public:
+    PCI_Config_Space(const uint8_t* data, uint16_t size);
+    explicit PCI_Config_Space(const PCI_DEVICE_INFO& device);
+
+    bool IsValid() const { return m_data != nullptr; }
+    bool IsExtended() const;
+    uint16_t Size() const { return m_size; }
+
+    uint8_t Read8(uint16_t offset) const;
+    uint16_t Read16(uint16_t offset) const;
+    uint32_t Read32(uint16_t offset) const;
+
+    std::vector<PCI_CAPABILITY> GetCapabilities() const;
+    uint16_t FindCapability(uint8_t id) const;
+    uint16_t FindExtendedCapability(uint16_t id) const;
+    bool GetLinkStatus(uint8_t& speed, uint8_t& width) const;
+    bool GetLink(PCI_LINK& link) const;
+    bool GetTuning(PCI_LINK_TUNING& tuning) const;
+    bool GetSriov(PCI_SRIOV& sriov) const;
+    std::string DescribeLink() const;
+
+    static const char* GetCapabilityName(const PCI_CAPABILITY& capability);
+
+private:
+    PCI_CAP_SOURCE GetSource() const;
+    static uint32_t ReadCallback(void* context, uint16_t offset);
+};
\ No newline at end of file
@@ -1,59 +1,873 @@
 #include "console_formatter.h"
+#include "config_space.h"
+#include "../PCICommon/pci_snapshot.h"
+#include <algorithm>
+#include <bit>
+#include <iterator>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
 
 void Console_Formatter::PrintHeader() {
     std::cout << "PCI Device Scanner\n";
     std::cout << "------------------\n\n";
 }
 
-void Console_Formatter::PrintDevices(const std::vector<PCI_DEVICE_INFO>& devices) {
-    if (devices.empty()) {
+//      ,   ,    
+void Console_Formatter::PrintDevices(const std::vector<PCI_DEVICE_INFO>& devices, OUTPUT_FORMAT format) {
+    if (devices.empty() && format == OUTPUT_FORMAT::Table) {
         std::cout << "No PCI devices found.\n";
         return;
     }
 
-    //   
-    constexpr int col_widths[] = { 8, 12, 8, 10, 40 };
+    static std::string buffer;
+    FormatDevices(devices, format, buffer);
+    WriteOutput(buffer);
+}
+
+//           :
+//  ,   push_back  
+void Console_Formatter::FormatDevices(const std::vector<PCI_DEVICE_INFO>& devices, OUTPUT_FORMAT format, std::string& out) {
+    size_t descriptions = 0;
+    for (const auto& device : devices) {
+        descriptions += device.Description.size();
+    }
+
+    //  JSON       (\u00XX)
+    out.resize(MaxHeaderSize + devices.size() * MaxRecordSize + descriptions * 6);
+
+    char* begin = out.data();
+    char* end = begin;
+    switch (format) {
+    case OUTPUT_FORMAT::JsonLines: end = FormatJsonLines(devices, begin); break;
+    case OUTPUT_FORMAT::Csv: end = FormatCsv(devices, begin); break;
+    default: end = FormatTable(devices, begin); break;
+    }
+    out.resize(static_cast<size_t>(end - begin));
+}
 
-    PrintTableRow({ "Addr", "Vendor:Device", "Class", "Rev", "Description" }, col_widths);
-    PrintSeparator(80);
+//  ,  ,  ;     
+char* Console_Formatter::FormatTable(const std::vector<PCI_DEVICE_INFO>& devices, char* out) {
+    constexpr const char* titles[] = { "Addr", "Vendor:Device", "Class", "Rev" };
 
+    size_t description = 11;
     for (const auto& device : devices) {
-        PrintTableRow({
-            device.GetLocation(),
-            device.GetVendorDeviceID(),
-            device.GetClassCodes(),
-            std::format("{:02X}", device.Revision),
-            device.Description
-            }, col_widths);
+        if (device.Description.size() > description) {
+            description = device.Description.size();
+        }
     }
+
+    size_t total = description;
+    for (size_t i = 0; i < 4; ++i) {
+        out = Pad(out, std::format_to(out, "{}", titles[i]), ColumnWidths[i]);
+        total += ColumnWidths[i];
+    }
+    out = std::format_to(out, "Description\n");
+    out = std::fill_n(out, total, '-');
+    *out++ = '\n';
+
+    for (const auto& device : devices) {
+        out = FormatTableRow(device, out);
+    }
+    return out;
 }
 
-void Console_Formatter::PrintStatistics(const std::vector<PCI_DEVICE_INFO>& devices) {
-    std::cout << "\nScan Statistics:\n";
-    std::cout << "----------------\n";
-    std::cout << "Total devices: " << devices.size() << "\n\n";
+char* Console_Formatter::FormatTableRow(const PCI_DEVICE_INFO& device, char* out) {
+    out = Pad(out, std::format_to(out, "{:04X}:{:02X}:{:02X}.{:X}", device.Segment, device.Bus, device.Device, device.Function), ColumnWidths[0]);
+    out = Pad(out, std::format_to(out, "{:04X}:{:04X}", device.VendorID, device.DeviceID), ColumnWidths[1]);
+    out = Pad(out, std::format_to(out, "{:02X}:{:02X}", device.BaseClass, device.SubClass), ColumnWidths[2]);
+    out = Pad(out, std::format_to(out, "{:02X}", device.Revision), ColumnWidths[3]);
+    out = std::copy(device.Description.begin(), device.Description.end(), out);
+    *out++ = '\n';
+    return out;
+}
+
+char* Console_Formatter::Pad(char* start, char* end, size_t width) {
+    size_t used = static_cast<size_t>(end - start);
+    return std::fill_n(end, used < width ? width - used : 1, ' ');
+}
+
+//   JSON  ;  -  ,   lspci
+char* Console_Formatter::FormatJsonLines(const std::vector<PCI_DEVICE_INFO>& devices, char* out) {
+    for (const auto& device : devices) {
+        *out++ = '{';
+        out = FormatJsonFields(device, out);
+        *out++ = '}';
+        *out++ = '\n';
+    }
+    return out;
+}
 
-    //   
-    std::map<UCHAR, int> classCount;
-    std::map<USHORT, int> vendorCount;
+char* Console_Formatter::FormatJsonFields(const PCI_DEVICE_INFO& device, char* out) {
+    out = std::format_to(out,
+        "\"bdf\":\"{:04x}:{:02x}:{:02x}.{:x}\",\"vendor_id\":\"{:04x}\",\"device_id\":\"{:04x}\","
+        "\"class\":\"{:02x}\",\"subclass\":\"{:02x}\",\"prog_if\":\"{:02x}\",\"revision\":\"{:02x}\","
+        "\"subsystem_vendor_id\":\"{:04x}\",\"subsystem_id\":\"{:04x}\",\"header_type\":\"{:02x}\",",
+        device.Segment, device.Bus, device.Device, device.Function, device.VendorID, device.DeviceID,
+        device.BaseClass, device.SubClass, device.ProgIF, device.Revision,
+        device.SubsystemVendorID, device.SubsystemID, device.HeaderType);
+    if (device.Virtual) {
+        out = std::format_to(out, "\"physfn\":\"{:04x}:{:02x}:{:02x}.{:x}\",", device.Segment, device.PhysicalFunction >> 8,
+            (device.PhysicalFunction >> 3) & 0x1F, device.PhysicalFunction & 7);
+    }
+    out = std::format_to(out, "\"description\":");
+    return AppendJsonString(out, device.Description);
+}
 
+char* Console_Formatter::FormatCsv(const std::vector<PCI_DEVICE_INFO>& devices, char* out) {
+    out = std::format_to(out, "{}\n", CsvColumns);
     for (const auto& device : devices) {
-        vendorCount[device.VendorID]++;
+        out = FormatCsvFields(device, out);
+        *out++ = '\n';
+    }
+    return out;
+}
+
+char* Console_Formatter::FormatCsvFields(const PCI_DEVICE_INFO& device, char* out) {
+    out = std::format_to(out, "{:04x}:{:02x}:{:02x}.{:x},{:04x},{:04x},{:02x},{:02x},{:02x},{:02x},{:04x},{:04x},{:02x},",
+        device.Segment, device.Bus, device.Device, device.Function, device.VendorID, device.DeviceID,
+        device.BaseClass, device.SubClass, device.ProgIF, device.Revision,
+        device.SubsystemVendorID, device.SubsystemID, device.HeaderType);
+    return AppendCsvField(out, device.Description);
+}
+
+char* Console_Formatter::AppendJsonString(char* out, std::string_view text) {
+    *out++ = '"';
+    for (char c : text) {
+        switch (c) {
+        case '"': *out++ = '\\'; *out++ = '"'; break;
+        case '\\': *out++ = '\\'; *out++ = '\\'; break;
+        case '\n': *out++ = '\\'; *out++ = 'n'; break;
+        case '\r': *out++ = '\\'; *out++ = 'r'; break;
+        case '\t': *out++ = '\\'; *out++ = 't'; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                out = std::format_to(out, "\\u{:04x}", static_cast<unsigned>(c));
+            }
+            else {
+                *out++ = c;
+            }
+        }
+    }
+    *out++ = '"';
+    return out;
+}
+
+//        (RFC 4180)
+char* Console_Formatter::AppendCsvField(char* out, std::string_view text) {
+    if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+        return std::copy(text.begin(), text.end(), out);
     }
 
+    *out++ = '"';
+    for (char c : text) {
+        if (c == '"') {
+            *out++ = '"';
+        }
+        *out++ = c;
+    }
+    *out++ = '"';
+    return out;
+}
+
+//   iostream   ,     
+void Console_Formatter::WriteOutput(std::string_view text) {
+    std::cout.flush();
+
+#ifdef _WIN32
+    HANDLE output = GetStdHandle(STD_OUTPUT_HANDLE);
+    while (!text.empty()) {
+        DWORD written = 0;
+        if (!WriteFile(output, text.data(), static_cast<DWORD>(text.size()), &written, nullptr) || written == 0) {
+            break;
+        }
+        text.remove_prefix(written);
+    }
+#else
+    while (!text.empty()) {
+        ssize_t written = write(STDOUT_FILENO, text.data(), text.size());
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            break;
+        }
+        text.remove_prefix(static_cast<size_t>(written));
+    }
+#endif
+}
+
+//    :      
+void Console_Formatter::PrintStatistics(const PCI_Device_Index& index) {
+    std::cout << "\nScan Statistics:\n";
+    std::cout << "----------------\n";
+    std::cout << "Total devices: " << index.Size() << "\n\n";
+
     std::cout << "Devices by class:\n";
-    for (const auto& [classCode, count] : classCount) {
-        std::cout << "  Class " << std::hex << static_cast<int>(classCode)
-            << std::dec << ": " << count << " devices\n";
+    for (unsigned classCode = 0; classCode < 256; ++classCode) {
+        size_t count = index.FindClass(static_cast<uint8_t>(classCode)).size();
+        if (count) {
+            std::cout << "  Class " << std::hex << classCode
+                << std::dec << ": " << count << " devices\n";
+        }
     }
 
     std::cout << "\nDevices by vendor:\n";
-    for (const auto& [vendorID, count] : vendorCount) {
+    const auto& runs = index.GetIdRuns();
+    for (size_t i = 0; i < runs.size();) {
+        uint16_t vendorID = static_cast<uint16_t>(runs[i].Id >> 16);
+        size_t count = index.FindVendor(vendorID).size();
+        while (i < runs.size() && static_cast<uint16_t>(runs[i].Id >> 16) == vendorID) {
+            ++i;
+        }
         std::cout << "  Vendor " << std::hex << vendorID
             << std::dec << ": " << count << " devices\n";
     }
 }
 
+//      ,    :    
+//  "added/removed/changed",   -    +/-/*
+void Console_Formatter::PrintDelta(const PCI_SCAN_DELTA& delta, OUTPUT_FORMAT format) {
+    static std::string buffer;
+    FormatDelta(delta, format, buffer);
+    WriteOutput(buffer);
+}
+
+void Console_Formatter::FormatDelta(const PCI_SCAN_DELTA& delta, OUTPUT_FORMAT format, std::string& out) {
+    size_t descriptions = 0;
+    for (const auto& change : delta.Changes) {
+        descriptions += change.Device.Description.size();
+    }
+
+    out.resize(MaxHeaderSize + delta.Changes.size() * (MaxRecordSize + 64) + descriptions * 6);
+
+    char* begin = out.data();
+    char* end = begin;
+    if (format == OUTPUT_FORMAT::Table) {
+        end = std::format_to(end, "Generation {}: {} change(s)\n", delta.Generation, delta.Changes.size());
+    }
+
+    for (const auto& change : delta.Changes) {
+        const char* event = change.Kind == PCI_CHANGE_KIND::Added ? "added"
+            : change.Kind == PCI_CHANGE_KIND::Removed ? "removed" : "changed";
+
+        switch (format) {
+        case OUTPUT_FORMAT::JsonLines:
+            end = std::format_to(end, "{{\"event\":\"{}\",\"generation\":{},", event, delta.Generation);
+            end = FormatJsonFields(change.Device, end);
+            *end++ = '}';
+            *end++ = '\n';
+            break;
+        case OUTPUT_FORMAT::Csv:
+            end = std::format_to(end, "{},{},", event, delta.Generation);
+            end = FormatCsvFields(change.Device, end);
+            *end++ = '\n';
+            break;
+        default:
+            *end++ = event[0] == 'a' ? '+' : event[0] == 'r' ? '-' : '*';
+            *end++ = ' ';
+            end = FormatTableRow(change.Device, end);
+            break;
+        }
+    }
+    out.resize(static_cast<size_t>(end - begin));
+}
+
+void Console_Formatter::PrintCapabilities(const std::vector<PCI_DEVICE_INFO>& devices) {
+    std::cout << "\nCapabilities:\n";
+    std::cout << "-------------\n";
+
+    for (const auto& device : devices) {
+        PCI_Config_Space config(device);
+        if (!config.IsValid()) {
+            continue;
+        }
+
+        std::cout << device.GetLocation() << " (" << config.Size() << " bytes)";
+        std::string link = config.DescribeLink();
+        if (!link.empty()) {
+            std::cout << " link " << link;
+        }
+        std::cout << "\n";
+
+        for (const auto& capability : config.GetCapabilities()) {
+            std::cout << std::format("  [{:03X}] {}", capability.Offset, PCI_Config_Space::GetCapabilityName(capability));
+            if (capability.Extended) {
+                std::cout << " v" << static_cast<int>(capability.Version);
+            }
+            std::cout << "\n";
+        }
+    }
+}
+
+//    - -   ,    
+void Console_Formatter::PrintResourceMap(const PCI_Resource_Map& map, const PCI_Resource_Map& ioPorts) {
+    std::cout << "\nResources:\n";
+    std::cout << "----------\n";
+
+    for (const auto& resource : map.GetResources()) {
+        PrintResource(resource);
+    }
+    if (ioPorts.Size()) {
+        std::cout << "I/O ports:\n";
+        for (const auto& resource : ioPorts.GetResources()) {
+            PrintResource(resource);
+        }
+    }
+
+    std::cout << map.Size() << " memory BARs and " << ioPorts.Size() << " I/O BARs mapped";
+    if (map.GetUnsizedCount()) {
+        std::cout << ", " << map.GetUnsizedCount() << " without known size";
+    }
+    std::cout << "\n";
+}
+
+void Console_Formatter::PrintAddressLookup(uint64_t address, const std::vector<const PCI_RESOURCE*>& matches) {
+    std::cout << std::format("\nAddress {:#x}:\n", address);
+
+    if (matches.empty()) {
+        std::cout << "  not claimed by any BAR\n";
+        return;
+    }
+    for (const PCI_RESOURCE* resource : matches) {
+        PrintResource(*resource);
+    }
+}
+
+void Console_Formatter::PrintResource(const PCI_RESOURCE& resource) {
+    std::cout << std::format("  {:016X}-{:016X} {:>10} {:<8} {:04X}:{:02X}:{:02X}.{:X} BAR{} {:04X}:{:04X}\n",
+        resource.Start, resource.End, resource.Bar.Size, GetBarTypeName(resource.Bar),
+        resource.Segment, resource.Bus, resource.Device, resource.Function, resource.Bar.Index, resource.VendorID, resource.DeviceID);
+}
+
+const char* Console_Formatter::GetBarTypeName(const PCI_BAR& bar) {
+    switch (bar.Type) {
+    case PCI_BAR_TYPE::Io: return "io";
+    case PCI_BAR_TYPE::Memory64: return bar.Prefetchable ? "mem64 pf" : "mem64";
+    default: return bar.Prefetchable ? "mem32 pf" : "mem32";
+    }
+}
+
+//    lspci -t:     ,
+//       , "|"    
+void Console_Formatter::PrintTopology(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology) {
+    std::cout << "\nTopology:\n";
+    std::cout << "---------\n";
+
+    std::string out;
+    const auto& roots = topology.GetRoots();
+    for (size_t i = 0; i < roots.size();) {
+        uint16_t segment = devices[roots[i]].Segment;
+        uint8_t bus = devices[roots[i]].Bus;
+        std::vector<uint32_t> children;
+        for (; i < roots.size() && devices[roots[i]].Segment == segment && devices[roots[i]].Bus == bus; ++i) {
+            children.push_back(roots[i]);
+        }
+
+        std::string label = std::format("-[{:04x}:{:02x}]-", segment, bus);
+        out += label;
+        FormatTopologyBus(devices, topology, children, std::string(label.size(), ' '), out);
+    }
+    WriteOutput(out);
+}
+
+void Console_Formatter::FormatTopologyBus(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology,
+    const std::vector<uint32_t>& children, const std::string& prefix, std::string& out) {
+    for (size_t i = 0; i < children.size(); ++i) {
+        bool last = i + 1 == children.size();
+        if (i == 0) {
+            out += last ? "--" : "+-";
+        }
+        else {
+            out += prefix;
+            out += last ? "\\-" : "+-";
+        }
+
+        const PCI_DEVICE_INFO& device = devices[children[i]];
+        const PCI_TOPOLOGY_NODE& node = topology.GetNode(children[i]);
+        std::string text = std::format("{:02x}.{:x}", device.Device, device.Function);
+        if (device.SecondaryBus > device.Bus) {
+            text += device.SubordinateBus > device.SecondaryBus
+                ? std::format("-[{:02x}-{:02x}]-", device.SecondaryBus, device.SubordinateBus)
+                : std::format("-[{:02x}]-", device.SecondaryBus);
+        }
+
+        if (node.FirstChild == PCI_Topology::None) {
+            out += text;
+            out += "  ";
+            out += device.Description;
+            out += "\n";
+            continue;
+        }
+
+        std::vector<uint32_t> grandchildren;
+        for (uint32_t child = node.FirstChild; child != PCI_Topology::None; child = topology.GetNode(child).NextSibling) {
+            grandchildren.push_back(child);
+        }
+
+        out += text;
+        FormatTopologyBus(devices, topology, grandchildren, prefix + (last ? "  " : "| ") + std::string(text.size(), ' '), out);
+    }
+}
+
+//        
+void Console_Formatter::PrintDevicePath(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology, uint32_t index) {
+    const PCI_DEVICE_INFO& device = devices[index];
+    std::cout << "\nPath of " << device.GetLocation() << " " << device.Description << ":\n";
+
+    auto path = topology.GetPathToRoot(index);
+    if (path.empty()) {
+        std::cout << "  on a root bus, no bridges\n";
+        return;
+    }
+    for (size_t i = 0; i < path.size(); ++i) {
+        const PCI_DEVICE_INFO& bridge = devices[path[i]];
+        std::cout << std::format("  {} {} [{:02X}-{:02X}]{}\n", bridge.GetLocation(), bridge.Description,
+            bridge.SecondaryBus, bridge.SubordinateBus, i + 1 == path.size() ? " root port" : "");
+    }
+}
+
+//     ,         
+void Console_Formatter::PrintAerTick(const Aer_Sampler& sampler, unsigned tick) {
+    for (size_t i = 0; i < sampler.GetChannelCount(); ++i) {
+        AER_LATCHED latched;
+        if (sampler.GetLastLatched(i, latched)) {
+            if (latched.Correctable || latched.NonFatal || latched.Fatal) {
+                std::cout << std::format("[{}] {} status bits newly latched: correctable {}, non-fatal {}, fatal {}\n",
+                    tick, sampler.GetDevice(i).GetLocation(), latched.Correctable, latched.NonFatal, latched.Fatal);
+            }
+            continue;
+        }
+
+        AER_RATE rate;
+        if (!sampler.GetLastRate(i, rate) || (rate.Correctable == 0 && rate.NonFatal == 0 && rate.Fatal == 0)) {
+            continue;
+        }
+        std::cout << std::format("[{}] {} correctable {:.1f}/s, non-fatal {:.1f}/s, fatal {:.1f}/s\n",
+            tick, sampler.GetDevice(i).GetLocation(), rate.Correctable, rate.NonFatal, rate.Fatal);
+    }
+    std::cout << std::flush;
+}
+
+//    ; ,      ,
+//    -        
+void Console_Formatter::PrintAerSummary(const Aer_Sampler& sampler) {
+    constexpr int col_widths[] = { 14, 10, 14, 12, 10, 10 };
+    size_t statusOnly = 0;
+
+    std::cout << "\nAER error rates over the sampling window:\n";
+    PrintTableRow({ "Addr", "Samples", "Correctable/s", "NonFatal/s", "Fatal/s", "Total" }, col_widths);
+    PrintSeparator(70);
+
+    for (size_t i = 0; i < sampler.GetChannelCount(); ++i) {
+        const PCI_DEVICE_INFO& device = sampler.GetDevice(i);
+        if (!sampler.IsSupported(i)) {
+            PrintTableRow({ device.GetLocation(), "-", "no AER", "", "", "" }, col_widths);
+            continue;
+        }
+        if (sampler.IsStatusOnly(i)) {
+            ++statusOnly;
+            continue;
+        }
+
+        const Aer_Sample_Ring& samples = sampler.GetSamples(i);
+        AER_RATE rate{};
+        sampler.GetWindowRate(i, rate);
+        const PCI_AER_COUNTERS& total = samples.Newest().Counters;
+        PrintTableRow({
+            device.GetLocation(),
+            std::to_string(samples.Size()),
+            std::format("{:.2f}", rate.Correctable),
+            std::format("{:.2f}", rate.NonFatal),
+            std::format("{:.2f}", rate.Fatal),
+            std::to_string(total.Correctable + total.NonFatal + total.Fatal)
+            }, col_widths);
+    }
+
+    if (!statusOnly) {
+        return;
+    }
+
+    std::cout << "\nAER status bits newly latched over the sampling window (no OS error counters;\n"
+        "sticky status registers show which error types occurred, not how often):\n";
+    PrintTableRow({ "Addr", "Samples", "Correctable", "NonFatal", "Fatal", "Set now" }, col_widths);
+    PrintSeparator(70);
+
+    for (size_t i = 0; i < sampler.GetChannelCount(); ++i) {
+        if (!sampler.IsSupported(i) || !sampler.IsStatusOnly(i)) {
+            continue;
+        }
+
+        const Aer_Sample_Ring& samples = sampler.GetSamples(i);
+        AER_LATCHED latched{};
+        sampler.GetWindowLatched(i, latched);
+        const PCI_AER_COUNTERS& status = samples.Newest().Counters;
+        PrintTableRow({
+            sampler.GetDevice(i).GetLocation(),
+            std::to_string(samples.Size()),
+            std::to_string(latched.Correctable),
+            std::to_string(latched.NonFatal),
+            std::to_string(latched.Fatal),
+            std::to_string(std::popcount(status.Correctable) + std::popcount(status.NonFatal) + std::popcount(status.Fatal))
+            }, col_widths);
+    }
+}
+
+//     -         
+//  ;  - ,     
+void Console_Formatter::PrintLinkReport(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Link_Report& report) {
+    constexpr int col_widths[] = { 14, 10, 10, 11, 11, 14, 6 };
+
+    std::cout << "\nPCIe bandwidth along the path to the root:\n";
+    if (report.GetPaths().empty()) {
+        std::cout << "  No PCIe link data (config space not captured or no PCIe endpoints)\n";
+        return;
+    }
+
+    PrintTableRow({ "Addr", "Link", "Capable", "Cap MB/s", "Path MB/s", "Limit", "Used" }, col_widths);
+    PrintSeparator(81);
+
+    size_t limited = 0;
+    for (const auto& path : report.GetPaths()) {
+        const PCI_LINK_STATE& state = report.GetLink(path.Index);
+        bool bottleneck = path.AvailableBandwidth < path.CapableBandwidth;
+        limited += bottleneck;
+
+        PrintTableRow({
+            devices[path.Index].GetLocation(),
+            FormatLink(state.Link.Speed, state.Link.Width),
+            FormatLink(state.CapableSpeed, state.CapableWidth),
+            std::format("{:.0f}", path.CapableBandwidth),
+            std::format("{:.0f}", path.AvailableBandwidth),
+            path.Bottleneck == path.Index ? "own" : devices[path.Bottleneck].GetLocation(),
+            path.CapableBandwidth > 0 ? std::format("{:.0f}%", path.AvailableBandwidth * 100 / path.CapableBandwidth) : "-"
+            }, col_widths);
+    }
+    std::cout << report.GetPaths().size() << " endpoints, " << limited << " limited below their own link capability\n";
+
+    if (!report.GetDegradedCount()) {
+        return;
+    }
+    std::cout << "\nLinks trained below capability:\n";
+    for (uint32_t i = 0; i < report.Size(); ++i) {
+        const PCI_LINK_STATE& state = report.GetLink(i);
+        if (state.Degraded) {
+            std::cout << std::format("  {} {:<11} {} of {}\n", devices[i].GetLocation(), GetPortTypeName(state.Link.PortType),
+                FormatLink(state.Link.Speed, state.Link.Width), FormatLink(state.CapableSpeed, state.CapableWidth));
+        }
+    }
+}
+
+// ,       
+//  ; "over" -  ASPM    
+void Console_Formatter::PrintTuningAudit(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Tuning_Audit& audit) {
+    constexpr int col_widths[] = { 14, 18, 9, 9, 14, 5 };
+
+    std::cout << "\nPCIe tuning audit:\n";
+    if (!audit.GetEndpointCount()) {
+        std::cout << "  No PCIe capability data (config space not captured or no PCIe endpoints)\n";
+        return;
+    }
+
+    if (!audit.GetFindings().empty()) {
+        PrintTableRow({ "Addr", "Issue", "Setting", "Limit", "At", "" }, col_widths);
+        PrintSeparator(74);
+    }
+
+    for (const auto& finding : audit.GetFindings()) {
+        bool hasValue = finding.Issue != PCI_TUNING_ISSUE::RelaxedOrderingOff;
+        PrintTableRow({
+            devices[finding.Index].GetLocation(),
+            GetTuningIssueName(finding.Issue),
+            hasValue ? FormatTuningValue(finding.Issue, finding.Value) : "-",
+            hasValue && finding.Limit ? FormatTuningValue(finding.Issue, finding.Limit) : "-",
+            finding.Peer != PCI_Topology::None ? devices[finding.Peer].GetLocation() : "-",
+            PCI_Tuning_Audit::ExceedsAcceptable(finding) ? "over" : ""
+            }, col_widths);
+    }
+    std::cout << audit.GetEndpointCount() << " endpoints audited, " << audit.GetFindings().size() << " findings\n";
+}
+
+std::string Console_Formatter::FormatTuningValue(PCI_TUNING_ISSUE issue, uint32_t value) {
+    switch (issue) {
+    case PCI_TUNING_ISSUE::AspmL0s:
+    case PCI_TUNING_ISSUE::AspmL1:
+        return value < 1000 ? std::format("{} ns", value) : std::format("{} us", value / 1000);
+    default:
+        return std::format("{} B", value);
+    }
+}
+
+const char* Console_Formatter::GetTuningIssueName(PCI_TUNING_ISSUE issue) {
+    switch (issue) {
+    case PCI_TUNING_ISSUE::PayloadMismatch: return "MPS mismatch";
+    case PCI_TUNING_ISSUE::PayloadBelowPath: return "MPS below path";
+    case PCI_TUNING_ISSUE::SmallReadRequest: return "small MRRS";
+    case PCI_TUNING_ISSUE::AspmL0s: return "ASPM L0s on";
+    case PCI_TUNING_ISSUE::AspmL1: return "ASPM L1 on";
+    case PCI_TUNING_ISSUE::RelaxedOrderingOff: return "relaxed order off";
+    default: return "other";
+    }
+}
+
+std::string Console_Formatter::FormatLink(uint8_t speed, uint8_t width) {
+    return std::format("x{} Gen{}", width, speed);
+}
+
+const char* Console_Formatter::GetPortTypeName(uint8_t portType) {
+    switch (portType) {
+    case PCI_EXP_TYPE_ENDPOINT: return "endpoint";
+    case PCI_EXP_TYPE_LEG_END: return "legacy ep";
+    case PCI_EXP_TYPE_ROOT_PORT: return "root port";
+    case PCI_EXP_TYPE_UPSTREAM: return "upstream";
+    case PCI_EXP_TYPE_DOWNSTREAM: return "downstream";
+    case PCI_EXP_TYPE_PCI_BRIDGE: return "pcie-pci";
+    case PCI_EXP_TYPE_PCIE_BRIDGE: return "pci-pcie";
+    default: return "other";
+    }
+}
+
+// :   CPU        CPU  NUMA-.
+//  :     /proc/interrupts,   .
+// "remote" -      ;     
+void Console_Formatter::PrintLocalityReport(const std::vector<PCI_DEVICE_INFO>& devices, const std::vector<PCI_LOCALITY_ENTRY>& entries) {
+    constexpr int col_widths[] = { 14, 5, 12, 5, 12, 7, 12, 11, 13 };
+
+    std::cout << "\nInterrupt locality:\n";
+    if (entries.empty()) {
+        std::cout << "  NUMA and interrupt data are not available from this backend\n";
+        return;
+    }
+
+    PrintTableRow({ "Addr", "Node", "Local CPUs", "MSI", "Target CPUs", "Local", "Boot CPUs", "Boot local", "" }, col_widths);
+    PrintSeparator(91);
+
+    size_t remote = 0;
+    for (const auto& entry : entries) {
+        const PCI_DEVICE_INFO& device = devices[entry.Index];
+        uint64_t total = entry.LocalInterrupts + entry.RemoteInterrupts;
+        uint32_t vectors = entry.LocalVectors + entry.RemoteVectors;
+        bool mostlyRemote = entry.HasAffinity ? entry.RemoteVectors > entry.LocalVectors : entry.RemoteInterrupts > entry.LocalInterrupts;
+        remote += mostlyRemote;
+
+        PrintTableRow({
+            device.GetLocation(),
+            device.NumaNode < 0 ? "-" : std::to_string(device.NumaNode),
+            device.LocalCpus.empty() ? "-" : device.LocalCpus,
+            device.MsiVectors ? std::to_string(device.MsiVectors) : "INTx",
+            !entry.HasAffinity ? "unknown" : entry.TargetCpus,
+            vectors ? std::format("{}/{}", entry.LocalVectors, vectors) : "-",
+            !entry.HasCounts ? "unknown" : entry.IrqCpus.empty() ? "none yet" : entry.IrqCpus,
+            total ? std::format("{}%", entry.LocalInterrupts * 100 / total) : "-",
+            !mostlyRemote ? "" : entry.HasAffinity ? "remote" : "remote (boot)"
+            }, col_widths);
+    }
+
+    std::cout << entries.size() << " devices with interrupts, " << remote << " targeted mostly off their local CPUs\n"
+        << "Target CPUs and Local: current effective affinity (local vectors / vectors).\n"
+        << "Boot CPUs and Boot local: /proc/interrupts totals since boot, including earlier affinity.\n";
+}
+
+//   ,       , 
+//       .  -    
+void Console_Formatter::PrintScanStats(const SCAN_STATS_SUMMARY& stats) {
+    constexpr size_t maxBuses = 8;
+    constexpr int col_widths[] = { 14, 12, 10 };
+    const Latency_Histogram& reads = stats.Reads;
+
+    std::cout << "\nScan instrumentation:\n";
+    std::cout << "---------------------\n";
+    if (reads.GetCount()) {
+        std::cout << std::format("Config reads: {} ({} absent), reading threads: {}\n",
+            reads.GetCount(), stats.AbsentReads, stats.Threads);
+        std::cout << std::format("Read latency, ns: mean {:.0f}, p50 {}, p90 {}, p99 {}, p99.9 {}, max {}\n",
+            reads.GetMean(), reads.GetPercentile(50), reads.GetPercentile(90), reads.GetPercentile(99),
+            reads.GetPercentile(99.9), reads.GetMax());
+    }
+    else {
+        std::cout << "Config reads: not observed by this backend\n";
+    }
+
+    std::cout << "\n";
+    for (size_t i = 0; i < stats.PhaseNs.size(); ++i) {
+        SCAN_PHASE phase = static_cast<SCAN_PHASE>(i);
+        bool nested = phase == SCAN_PHASE::Decode || phase == SCAN_PHASE::NameLookup;
+        std::cout << std::format("  {:<16}{:>10.3f} ms\n", std::string(nested ? "  " : "") + GetScanPhaseName(phase),
+            stats.PhaseNs[i] / 1e6);
+    }
+
+    if (stats.Buses.empty()) {
+        return;
+    }
+
+    std::vector<std::pair<uint32_t, SCAN_BUS_PROBES>> busiest(stats.Buses);
+    size_t shown = std::min(maxBuses, busiest.size());
+    std::partial_sort(busiest.begin(), busiest.begin() + shown, busiest.end(), [](const auto& a, const auto& b) {
+        return a.second.Reads != b.second.Reads ? a.second.Reads > b.second.Reads : a.first < b.first;
+    });
+
+    std::cout << "\n";
+    PrintTableRow({ "Bus", "Reads", "Absent" }, col_widths);
+    PrintSeparator(36);
+    for (size_t i = 0; i < shown; ++i) {
+        const auto& [key, probes] = busiest[i];
+        PrintTableRow({
+            std::format("{:04X}:{:02X}", key >> 8, key & 0xFF),
+            std::to_string(probes.Reads),
+            std::to_string(probes.Absent)
+            }, col_widths);
+    }
+    std::cout << shown << " of " << stats.Buses.size() << " buses\n";
+}
+
+//   JSON;  -      [ , ]
+void Console_Formatter::FormatScanStatsJson(const SCAN_STATS_SUMMARY& stats, std::string& out) {
+    const Latency_Histogram& reads = stats.Reads;
+    auto it = std::back_inserter(out);
+
+    out.clear();
+    std::format_to(it, "{{\"config_reads\":{},\"absent_reads\":{},\"threads\":{},\"phases_ns\":{{",
+        reads.GetCount(), stats.AbsentReads, stats.Threads);
+    for (size_t i = 0; i < stats.PhaseNs.size(); ++i) {
+        std::string name = GetScanPhaseName(static_cast<SCAN_PHASE>(i));
+        std::replace(name.begin(), name.end(), ' ', '_');
+        std::format_to(it, "{}\"{}\":{}", i ? "," : "", name, stats.PhaseNs[i]);
+    }
+
+    std::format_to(it, "}},\"read_latency_ns\":{{\"mean\":{:.1f},\"p50\":{},\"p90\":{},\"p99\":{},\"p999\":{},\"max\":{},\"buckets\":[",
+        reads.GetMean(), reads.GetPercentile(50), reads.GetPercentile(90), reads.GetPercentile(99),
+        reads.GetPercentile(99.9), reads.GetMax());
+    bool first = true;
+    for (unsigned i = 0; i < Latency_Histogram::BucketCount; ++i) {
+        if (reads.GetBucket(i)) {
+            std::format_to(it, "{}[{},{}]", first ? "" : ",", Latency_Histogram::GetUpperBound(i), reads.GetBucket(i));
+            first = false;
+        }
+    }
+
+    out += "]},\"buses\":[";
+    for (size_t i = 0; i < stats.Buses.size(); ++i) {
+        const auto& [key, probes] = stats.Buses[i];
+        std::format_to(it, "{}{{\"bus\":\"{:04x}:{:02x}\",\"reads\":{},\"absent\":{}}}",
+            i ? "," : "", key >> 8, key & 0xFF, probes.Reads, probes.Absent);
+    }
+    out += "]}\n";
+}
+
+const char* Console_Formatter::GetScanPhaseName(SCAN_PHASE phase) {
+    switch (phase) {
+    case SCAN_PHASE::Open: return "open";
+    case SCAN_PHASE::Enumerate: return "enumerate";
+    case SCAN_PHASE::Decode: return "decode";
+    case SCAN_PHASE::NameLookup: return "name lookup";
+    case SCAN_PHASE::Format: return "format";
+    default: return "other";
+    }
+}
+
+void Console_Formatter::PrintAerBenchmark(const AER_BENCH_RESULT& result) {
+    std::cout << "AER sampling: " << result.Devices << " devices, " << result.Ticks << " ticks\n";
+    std::cout << std::format("  {:.2f} us per tick, {:.2f} us per device per tick\n",
+        result.MicrosecondsPerTick, result.MicrosecondsPerDevice);
+}
+
+void Console_Formatter::PrintBenchmark(const std::vector<SCAN_BENCH_RESULT>& results) {
+    constexpr int col_widths[] = { 10, 12, 16, 10 };
+
+    PrintTableRow({ "Threads", "Functions", "ms/scan", "Speedup" }, col_widths);
+    PrintSeparator(48);
+
+    for (const auto& result : results) {
+        PrintTableRow({
+            std::to_string(result.Threads),
+            std::to_string(result.Functions),
+            std::format("{:.3f}", result.MillisecondsPerScan),
+            std::format("{:.2f}x", result.Speedup)
+            }, col_widths);
+    }
+}
+
+void Console_Formatter::PrintTopologyBenchmark(const SYNTHETIC_TOPOLOGY_STATS& topology, unsigned latencyNs,
+    const std::vector<TOPOLOGY_BENCH_RESULT>& results) {
+    std::cout << "Topology: " << topology.Buses << " buses, " << topology.Bridges << " bridges, "
+        << topology.Functions << " functions (" << topology.PhysicalFunctions << " PFs, "
+        << topology.VirtualFunctions << " VFs)\n";
+    std::cout << "Read latency: " << latencyNs << " ns\n\n";
+
+    constexpr int col_widths[] = { 18, 10, 11, 14, 14 };
+
+    PrintTableRow({ "Method", "Probes", "Functions", "ms/scan", "Reads/s" }, col_widths);
+    PrintSeparator(67);
+
+    for (const auto& result : results) {
+        PrintTableRow({
+            result.Method,
+            std::to_string(result.Probes),
+            std::to_string(result.FunctionsFound),
+            std::format("{:.3f}", result.MillisecondsPerScan),
+            std::format("{:.0f}", result.ReadsPerSecond)
+            }, col_widths);
+    }
+}
+
+//    ,    
+void Console_Formatter::PrintFleetDiff(const std::vector<FLEET_DIFF_RESULT>& results) {
+    size_t identical = 0, different = 0, invalid = 0;
+
+    for (const auto& result : results) {
+        if (!result.Valid) {
+            std::cout << result.Path << ": not an inventory snapshot\n";
+            ++invalid;
+            continue;
+        }
+        if (result.Changes.empty()) {
+            ++identical;
+            continue;
+        }
+
+        ++different;
+        std::cout << result.Path;
+        if (!result.HostName.empty()) {
+            std::cout << " (" << result.HostName << ")";
+        }
+        std::cout << ": " << result.Changes.size() << " change(s)\n";
+        for (const auto& change : result.Changes) {
+            PrintInventoryChange(change);
+        }
+    }
+
+    std::cout << "\nSnapshots: " << results.size() << ", identical: " << identical
+        << ", different: " << different << ", invalid: " << invalid << "\n";
+}
+
+void Console_Formatter::PrintInventoryChange(const PCI_INVENTORY_CHANGE& change) {
+    const PCI_INVENTORY_RECORD& record = change.Kind == PCI_CHANGE_KIND::Removed ? change.Base : change.Other;
+    const char* mark = change.Kind == PCI_CHANGE_KIND::Added ? "+"
+        : change.Kind == PCI_CHANGE_KIND::Removed ? "-"
+        : change.LinkDowngraded ? "!" : "*";
+
+    std::cout << std::format("  {} {:04X}:{:02X}:{:02X}.{:X} {:04X}:{:04X} {:02X}:{:02X}", mark,
+        record.Segment, record.Bus, PCI_DEVFN_DEVICE(record.DevFn), PCI_DEVFN_FUNCTION(record.DevFn),
+        record.VendorID, record.DeviceID, record.BaseClass, record.SubClass);
+
+    if (change.Kind == PCI_CHANGE_KIND::Changed) {
+        if (change.Base.VendorID != change.Other.VendorID || change.Base.DeviceID != change.Other.DeviceID) {
+            std::cout << std::format(" was {:04X}:{:04X}", change.Base.VendorID, change.Base.DeviceID);
+        }
+        if (change.Base.Revision != change.Other.Revision) {
+            std::cout << std::format(" rev {:02X} -> {:02X}", change.Base.Revision, change.Other.Revision);
+        }
+        if (change.LinkDowngraded) {
+            std::cout << std::format(" link x{} Gen{} -> x{} Gen{}", change.Base.LinkWidth, change.Base.LinkSpeed,
+                change.Other.LinkWidth, change.Other.LinkSpeed);
+        }
+    }
+    std::cout << "\n";
+}
+
 void Console_Formatter::PrintTableRow(const std::vector<std::string>& columns, const int widths[]) {
     for (size_t i = 0; i < columns.size(); ++i) {
         std::cout << std::left << std::setw(widths[i]) << columns[i];
@@ -1,17 +1,82 @@
 #pragma once
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include <string_view>
 #include <vector>
-#include <map>
 #include "pci_device_info.h"
+#include "scan_delta.h"
+#include "scan_benchmark.h"
+#include "fleet_diff.h"
+#include "resource_map.h"
+#include "pci_topology.h"
+#include "pci_device_index.h"
+#include "aer_sampler.h"
+#include "irq_locality.h"
+#include "link_report.h"
+#include "tuning_audit.h"
+#include "scan_stats.h"
+
+enum class OUTPUT_FORMAT {
+    Table,
+    JsonLines,
+    Csv
+};
 
 class Console_Formatter {
 public:
     static void PrintHeader();
-    static void PrintDevices(const std::vector<PCI_DEVICE_INFO>& devices);
-    static void PrintStatistics(const std::vector<PCI_DEVICE_INFO>& devices);
+    static void PrintDevices(const std::vector<PCI_DEVICE_INFO>& devices, OUTPUT_FORMAT format = OUTPUT_FORMAT::Table);
+    static void FormatDevices(const std::vector<PCI_DEVICE_INFO>& devices, OUTPUT_FORMAT format, std::string& out);
+    static const char* GetCsvColumns() { return CsvColumns; }
+    static void PrintStatistics(const PCI_Device_Index& index);
+    static void PrintDelta(const PCI_SCAN_DELTA& delta, OUTPUT_FORMAT format = OUTPUT_FORMAT::Table);
+    static void FormatDelta(const PCI_SCAN_DELTA& delta, OUTPUT_FORMAT format, std::string& out);
+    static void PrintCapabilities(const std::vector<PCI_DEVICE_INFO>& devices);
+    static void PrintResourceMap(const PCI_Resource_Map& map, const PCI_Resource_Map& ioPorts);
+    static void PrintTopology(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology);
+    static void PrintDevicePath(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology, uint32_t index);
+    static void PrintAddressLookup(uint64_t address, const std::vector<const PCI_RESOURCE*>& matches);
+    static void PrintBenchmark(const std::vector<SCAN_BENCH_RESULT>& results);
+    static void PrintTopologyBenchmark(const SYNTHETIC_TOPOLOGY_STATS& topology, unsigned latencyNs,
+        const std::vector<TOPOLOGY_BENCH_RESULT>& results);
+    static void PrintFleetDiff(const std::vector<FLEET_DIFF_RESULT>& results);
+    static void PrintAerTick(const Aer_Sampler& sampler, unsigned tick);
+    static void PrintAerSummary(const Aer_Sampler& sampler);
+    static void PrintAerBenchmark(const AER_BENCH_RESULT& result);
+    static void PrintLinkReport(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Link_Report& report);
+    static void PrintTuningAudit(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Tuning_Audit& audit);
+    static void PrintLocalityReport(const std::vector<PCI_DEVICE_INFO>& devices, const std::vector<PCI_LOCALITY_ENTRY>& entries);
+    static void PrintScanStats(const SCAN_STATS_SUMMARY& stats);
+    static void FormatScanStatsJson(const SCAN_STATS_SUMMARY& stats, std::string& out);
 
 private:
+    static constexpr size_t MaxHeaderSize = 512;
+    static constexpr size_t MaxRecordSize = 320;
+    static constexpr size_t ColumnWidths[] = { 14, 15, 7, 5 };
+    static constexpr const char* CsvColumns =
+        "bdf,vendor_id,device_id,class,subclass,prog_if,revision,subsystem_vendor_id,subsystem_id,header_type,description";
+
+    static char* FormatTable(const std::vector<PCI_DEVICE_INFO>& devices, char* out);
+    static char* FormatTableRow(const PCI_DEVICE_INFO& device, char* out);
+    static char* Pad(char* start, char* end, size_t width);
+    static char* FormatJsonLines(const std::vector<PCI_DEVICE_INFO>& devices, char* out);
+    static char* FormatJsonFields(const PCI_DEVICE_INFO& device, char* out);
+    static char* FormatCsv(const std::vector<PCI_DEVICE_INFO>& devices, char* out);
+    static char* FormatCsvFields(const PCI_DEVICE_INFO& device, char* out);
+    static char* AppendJsonString(char* out, std::string_view text);
+    static char* AppendCsvField(char* out, std::string_view text);
+    static void WriteOutput(std::string_view text);
     static void PrintTableRow(const std::vector<std::string>& columns, const int widths[]);
     static void PrintSeparator(int length);
+    static void PrintInventoryChange(const PCI_INVENTORY_CHANGE& change);
+    static void PrintResource(const PCI_RESOURCE& resource);
+    static void FormatTopologyBus(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology,
+        const std::vector<uint32_t>& children, const std::string& prefix, std::string& out);
+    static const char* GetBarTypeName(const PCI_BAR& bar);
+    static const char* GetPortTypeName(uint8_t portType);
+    static std::string FormatLink(uint8_t speed, uint8_t width);
+    static std::string FormatTuningValue(PCI_TUNING_ISSUE issue, uint32_t value);
+    static const char* GetTuningIssueName(PCI_TUNING_ISSUE issue);
+    static const char* GetScanPhaseName(SCAN_PHASE phase);
 };
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "driver_backend.h"
+#ifdef _WIN32
+#include <stdexcept>
+#include <format>
+#include "pci_decoder.h"
+#include "../PCICommon/pci_config.h"
+
+Driver_Backend::~Driver_Backend() {
+    Close();
+}
+
+bool Driver_Backend::Open() {
+    m_hDevice = CreateFileW(
+        L"\\\\.\\PCIScanner",
+        GENERIC_READ | GENERIC_WRITE,
+        0,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+
+    return (m_hDevice != INVALID_HANDLE_VALUE);
+}
+
+void Driver_Backend::Close() {
+    if (m_hDevice && m_hDevice != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_hDevice);
+        m_hDevice = nullptr;
+    }
+}
+
+void Driver_Backend::Enumerate(std::vector<PCI_DEVICE_INFO>& devices) {
+    if (!IsOpen()) {
+        throw std::runtime_error("Driver not opened");
+    }
+
+    //     -  ; ,      
+    constexpr int maxAttempts = 4;
+    const PCI_WIRE_HEADER* header = nullptr;
+
+    //   (     ) 
+    //       .     ,
+    //      
+    struct {
+        PCI_WIRE_REQUEST Request;
+        PCI_FILTER Filter;
+    } input{};
+    PCI_WIRE_REQUEST& request = input.Request;
+    request.Version = PCI_WIRE_VERSION;
+    request.Flags = PCI_WIRE_FLAG_CONFIG;
+    request.ConfigSize = m_captureConfig ? PCI_CFG_SPACE_SIZE : PCI_CFG_HEADER_SIZE;
+
+    DWORD inputSize = sizeof(PCI_WIRE_REQUEST);
+    if (m_filter.Flags) {
+        request.Flags |= PCI_WIRE_FLAG_FILTER;
+        input.Filter = m_filter;
+        inputSize = sizeof(input);
+    }
+
+    for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+        m_buffer.resize(PciWireBufferSize(m_expectedCount, request.ConfigSize));
+        DWORD bytesReturned = 0;
+
+        BOOL result = DeviceIoControl(
+            m_hDevice,
+            IOCTL_PCI_GET_DEVICES,
+            &input, inputSize,
+            m_buffer.data(), static_cast<DWORD>(m_buffer.size()),
+            &bytesReturned,
+            nullptr
+        );
+
+        if (!result) {
+            DWORD error = GetLastError();
+            if (error != ERROR_MORE_DATA) {
+                throw std::runtime_error(std::format("DeviceIoControl failed with error: {}", error));
+            }
+        }
+
+        PCI_WIRE_STATUS status = PciWireValidate(m_buffer.data(), bytesReturned);
+        if (status != PCI_WIRE_OK) {
+            throw std::runtime_error(std::format("Unsupported driver response (wire status {})", static_cast<int>(status)));
+        }
+
+        header = reinterpret_cast<const PCI_WIRE_HEADER*>(m_buffer.data());
+        if (header->RecordCount == header->TotalCount) {
+            break;
+        }
+
+        m_expectedCount = header->TotalCount + header->TotalCount / 8 + 1;
+        header = nullptr;
+    }
+
+    if (!header) {
+        throw std::runtime_error("Device list kept changing during scan");
+    }
+
+    //     ,     
+    devices.resize(header->RecordCount);
+    Scan_Phase_Timer decode(m_stats, SCAN_PHASE::Decode);
+    for (uint32_t i = 0; i < header->RecordCount; ++i) {
+        PCI_DEVICE_INFO& device = devices[i];
+        PCI_Config_Decoder::DecodeWireRecord(*PciWireRecordAt(m_buffer.data(), i), device);
+
+        //      :       
+        const uint8_t* config = header->ConfigSize ? PciWireRecordConfig(m_buffer.data(), i) : nullptr;
+        if (config) {
+            PCI_Config_Decoder::DecodeHeader(config, header->ConfigSize, device);
+        }
+        device.Config = m_captureConfig ? config : nullptr;
+        device.ConfigSize = m_captureConfig && config ? header->ConfigSize : 0;
+    }
+
+    m_expectedCount = header->TotalCount;
+}
+
+bool Driver_Backend::IsOpen() const {
+    return m_hDevice && m_hDevice != INVALID_HANDLE_VALUE;
+}
+Driver_Ring_Backend::~Driver_Ring_Backend() {
+    Close();
+}
+
+//          ;
+//     
+bool Driver_Ring_Backend::Open() {
+    m_hDevice = CreateFileW(
+        L"\\\\.\\PCIScanner",
+        GENERIC_READ | GENERIC_WRITE,
+        0,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (m_hDevice == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    PCI_RING_MAP_REQUEST request{};
+    request.Version = PCI_RING_VERSION;
+    request.ConfigSize = PCI_CFG_SPACE_SIZE;
+    request.Capacity = DefaultCapacity;
+
+    PCI_RING_MAP_RESPONSE response{};
+    DWORD bytesReturned = 0;
+    BOOL result = DeviceIoControl(m_hDevice, IOCTL_PCI_MAP_RING, &request, sizeof(request),
+        &response, sizeof(response), &bytesReturned, nullptr);
+
+    if (!result || bytesReturned < sizeof(response) ||
+        !PciRingAttach(&m_ring, reinterpret_cast<void*>(static_cast<uintptr_t>(response.Address)), response.Size)) {
+        DWORD error = result ? ERROR_REVISION_MISMATCH : GetLastError();
+        Close();
+        SetLastError(error);
+        return false;
+    }
+    return true;
+}
+
+void Driver_Ring_Backend::Close() {
+    if (m_hDevice && m_hDevice != INVALID_HANDLE_VALUE) {
+        CloseHandle(m_hDevice);
+    }
+    m_hDevice = nullptr;
+    m_ring = {};
+}
+
+bool Driver_Ring_Backend::IsOpen() const {
+    return m_hDevice && m_hDevice != INVALID_HANDLE_VALUE && m_ring.Header;
+}
+
+//       :   
+//  ,         
+void Driver_Ring_Backend::Produce(uint16_t configSize) {
+    struct {
+        PCI_WIRE_REQUEST Request;
+        PCI_FILTER Filter;
+    } input{};
+    input.Request.Version = PCI_WIRE_VERSION;
+    input.Request.Flags = PCI_WIRE_FLAG_CONFIG;
+    input.Request.ConfigSize = configSize;
+
+    DWORD inputSize = sizeof(PCI_WIRE_REQUEST);
+    if (m_filter.Flags) {
+        input.Request.Flags |= PCI_WIRE_FLAG_FILTER;
+        input.Filter = m_filter;
+        inputSize = sizeof(input);
+    }
+
+    DWORD bytesReturned = 0;
+    if (!DeviceIoControl(m_hDevice, IOCTL_PCI_SCAN_RING, &input, inputSize, nullptr, 0, &bytesReturned, nullptr)) {
+        //  (STATUS_IO_TIMEOUT)     
+        DWORD error = GetLastError();
+        if (error != ERROR_SEM_TIMEOUT) {
+            throw std::runtime_error(std::format("Ring scan request failed with error: {}", error));
+        }
+    }
+}
+#endif
\ No newline at end of file
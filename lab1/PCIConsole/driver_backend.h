@@ -0,0 +1,47 @@
+#pragma once
+#ifdef _WIN32
+#include <windows.h>
+#include <vector>
+#include "pci_backend.h"
+#include "ring_backend.h"
+
+class Driver_Backend : public PCI_Backend {
+private:
+    HANDLE m_hDevice{ nullptr };
+    std::vector<uint8_t> m_buffer;
+    uint32_t m_expectedCount{ 0 };
+
+public:
+    Driver_Backend() = default;
+    ~Driver_Backend() override;
+
+    Driver_Backend(const Driver_Backend&) = delete;
+    Driver_Backend& operator=(const Driver_Backend&) = delete;
+
+    bool Open() override;
+    void Close() override;
+    bool IsOpen() const override;
+    void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) override;
+    const char* GetName() const override { return "driver"; }
+};
+
+class Driver_Ring_Backend : public Ring_Backend {
+private:
+    HANDLE m_hDevice{ nullptr };
+
+public:
+    Driver_Ring_Backend() = default;
+    ~Driver_Ring_Backend() override;
+
+    Driver_Ring_Backend(const Driver_Ring_Backend&) = delete;
+    Driver_Ring_Backend& operator=(const Driver_Ring_Backend&) = delete;
+
+    bool Open() override;
+    void Close() override;
+    bool IsOpen() const override;
+    const char* GetName() const override { return "ring"; }
+
+protected:
+    void Produce(uint16_t configSize) override;
+};
+#endif
\ No newline at end of file
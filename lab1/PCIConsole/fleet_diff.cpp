@@ -0,0 +1,47 @@
+#include "fleet_diff.h"
+#include <algorithm>
+#include <filesystem>
+#include "worker_pool.h"
+
+//  -     ;    
+std::vector<std::string> Fleet_Diff::ListInventories(const std::string& target) {
+    std::vector<std::string> paths;
+    std::error_code error;
+
+    if (!std::filesystem::is_directory(target, error)) {
+        paths.push_back(target);
+        return paths;
+    }
+
+    for (const auto& entry : std::filesystem::directory_iterator(target, error)) {
+        if (entry.is_regular_file(error)) {
+            paths.push_back(entry.path().string());
+        }
+    }
+
+    std::sort(paths.begin(), paths.end());
+    return paths;
+}
+
+//   ,       -
+//     ,    
+std::vector<FLEET_DIFF_RESULT> Fleet_Diff::Run(const PCI_Inventory& base, const std::vector<std::string>& paths, unsigned threadCount) {
+    std::vector<FLEET_DIFF_RESULT> results(paths.size());
+    Worker_Pool pool(threadCount ? threadCount : Worker_Pool::GetDefaultThreadCount());
+
+    pool.ParallelFor(paths.size(), [&](size_t index) {
+        FLEET_DIFF_RESULT& result = results[index];
+        result.Path = paths[index];
+
+        PCI_Inventory inventory;
+        if (!inventory.Open(result.Path)) {
+            return;
+        }
+
+        result.Valid = true;
+        result.HostName = inventory.GetHostName();
+        PCI_Inventory::Compare(base, inventory, result.Changes);
+    });
+
+    return results;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "pci_inventory.h"
+
+struct FLEET_DIFF_RESULT {
+    std::string Path;
+    std::string HostName;
+    bool Valid{ false };
+    std::vector<PCI_INVENTORY_CHANGE> Changes;
+};
+
+class Fleet_Diff {
+public:
+    static std::vector<std::string> ListInventories(const std::string& target);
+    static std::vector<FLEET_DIFF_RESULT> Run(const PCI_Inventory& base, const std::vector<std::string>& paths, unsigned threadCount);
+};
\ No newline at end of file
@@ -0,0 +1,282 @@
+#include "irq_locality.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <format>
+
+//  procfs   ,     
+static bool ReadProcFile(const std::string& path, std::string& text) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+
+    text.clear();
+    char chunk[65536];
+    size_t bytesRead;
+    while ((bytesRead = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+        text.append(chunk, bytesRead);
+    }
+    std::fclose(file);
+    return true;
+}
+
+//   interrupts   irq     
+bool Proc_Interrupts::Load(const std::string& path, std::vector<uint32_t> irqs) {
+    std::sort(irqs.begin(), irqs.end());
+    irqs.erase(std::unique(irqs.begin(), irqs.end()), irqs.end());
+    m_irqs = std::move(irqs);
+
+    size_t slash = path.find_last_of('/');
+    LoadAffinity((slash == std::string::npos ? std::string(".") : path.substr(0, slash)) + "/irq");
+
+    std::string text;
+    if (!ReadProcFile(path, text)) {
+        Parse({});
+        return false;
+    }
+
+    Parse(text);
+    return true;
+}
+
+// effective_affinity_list - CPU,       ;
+// smp_affinity_list       .    
+void Proc_Interrupts::LoadAffinity(const std::string& irqRoot) {
+    m_affinity.assign(m_irqs.size(), {});
+
+    std::string text;
+    for (size_t i = 0; i < m_irqs.size(); ++i) {
+        if (ReadProcFile(std::format("{}/{}/effective_affinity_list", irqRoot, m_irqs[i]), text)) {
+            m_affinity[i] = text.substr(0, text.find('\n'));
+        }
+    }
+}
+
+//    :     , 
+// ( , NMI, LOC  ..)    
+void Proc_Interrupts::Parse(std::string_view text) {
+    size_t pos = text.find('\n');
+    ParseHeader(text.substr(0, pos));
+    pos = (pos == std::string_view::npos) ? text.size() : pos + 1;
+
+    m_counts.assign(m_irqs.size() * m_cpus.size(), 0);
+    m_found.assign(m_irqs.size(), 0);
+
+    while (pos < text.size()) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string_view::npos) {
+            end = text.size();
+        }
+        const char* cursor = text.data() + pos;
+        const char* lineEnd = text.data() + end;
+        pos = end + 1;
+
+        // "  24:   0   1234   PCI-MSI 524288-edge   nvme0q0" - ,     CPU
+        while (cursor < lineEnd && *cursor == ' ') {
+            ++cursor;
+        }
+        uint32_t irq = 0;
+        auto [next, error] = std::from_chars(cursor, lineEnd, irq);
+        if (error != std::errc() || next == lineEnd || *next != ':') {
+            continue;
+        }
+
+        auto found = std::lower_bound(m_irqs.begin(), m_irqs.end(), irq);
+        if (found == m_irqs.end() || *found != irq) {
+            continue;
+        }
+
+        size_t index = static_cast<size_t>(found - m_irqs.begin());
+        uint64_t* counts = m_counts.data() + index * m_cpus.size();
+        m_found[index] = 1;
+
+        cursor = next + 1;
+        for (size_t cpu = 0; cpu < m_cpus.size(); ++cpu) {
+            while (cursor < lineEnd && *cursor == ' ') {
+                ++cursor;
+            }
+            auto [after, countError] = std::from_chars(cursor, lineEnd, counts[cpu]);
+            if (countError != std::errc()) {
+                break;
+            }
+            cursor = after;
+        }
+    }
+}
+
+//  "CPU0 CPU1 ..." -  CPU   ,  
+//    ,    
+void Proc_Interrupts::ParseHeader(std::string_view line) {
+    m_cpus.clear();
+
+    size_t pos = 0;
+    while ((pos = line.find("CPU", pos)) != std::string_view::npos) {
+        pos += 3;
+        uint32_t cpu = 0;
+        auto [next, error] = std::from_chars(line.data() + pos, line.data() + line.size(), cpu);
+        if (error == std::errc()) {
+            m_cpus.push_back(cpu);
+            pos = static_cast<size_t>(next - line.data());
+        }
+    }
+}
+
+const uint64_t* Proc_Interrupts::GetCounts(uint32_t irq) const {
+    auto found = std::lower_bound(m_irqs.begin(), m_irqs.end(), irq);
+    if (found == m_irqs.end() || *found != irq || !m_found[found - m_irqs.begin()]) {
+        return nullptr;
+    }
+    return m_counts.data() + static_cast<size_t>(found - m_irqs.begin()) * m_cpus.size();
+}
+
+const std::string* Proc_Interrupts::GetAffinity(uint32_t irq) const {
+    auto found = std::lower_bound(m_irqs.begin(), m_irqs.end(), irq);
+    if (found == m_irqs.end() || *found != irq || static_cast<size_t>(found - m_irqs.begin()) >= m_affinity.size()) {
+        return nullptr;
+    }
+    const std::string& affinity = m_affinity[found - m_irqs.begin()];
+    return affinity.empty() ? nullptr : &affinity;
+}
+
+//  local_cpulist: "0-7,16-23"
+bool Irq_Locality::ParseCpuList(std::string_view text, std::vector<bool>& cpus) {
+    cpus.clear();
+
+    const char* cursor = text.data();
+    const char* end = text.data() + text.size();
+    while (cursor < end && *cursor != '\n') {
+        uint32_t first = 0;
+        uint32_t last = 0;
+        auto [next, error] = std::from_chars(cursor, end, first);
+        if (error != std::errc()) {
+            return false;
+        }
+        last = first;
+        cursor = next;
+
+        if (cursor < end && *cursor == '-') {
+            auto [after, rangeError] = std::from_chars(cursor + 1, end, last);
+            if (rangeError != std::errc() || last < first) {
+                return false;
+            }
+            cursor = after;
+        }
+
+        if (cpus.size() <= last) {
+            cpus.resize(last + 1);
+        }
+        std::fill(cpus.begin() + first, cpus.begin() + last + 1, true);
+
+        if (cursor < end && *cursor == ',') {
+            ++cursor;
+        }
+    }
+    return true;
+}
+
+std::string Irq_Locality::FormatCpuList(const std::vector<bool>& cpus) {
+    std::string out;
+
+    for (size_t cpu = 0; cpu < cpus.size(); ++cpu) {
+        if (!cpus[cpu]) {
+            continue;
+        }
+        size_t last = cpu;
+        while (last + 1 < cpus.size() && cpus[last + 1]) {
+            ++last;
+        }
+
+        if (!out.empty()) {
+            out += ',';
+        }
+        out += (last == cpu) ? std::format("{}", cpu) : std::format("{}-{}", cpu, last);
+        cpu = last;
+    }
+    return out;
+}
+
+//    ,  effective_affinity_list: , 
+//     CPU  local_cpulist,  .  /proc/interrupts
+//         -    CPU .
+//  local_cpulist      
+void Irq_Locality::Build(const std::vector<PCI_DEVICE_INFO>& devices, const Proc_Interrupts& interrupts,
+    std::vector<PCI_LOCALITY_ENTRY>& entries) {
+    const std::vector<uint32_t>& cpus = interrupts.GetCpus();
+    std::vector<uint64_t> perCpu(cpus.size());
+    std::vector<bool> local;
+    std::vector<bool> serviced;
+    std::vector<bool> affinity;
+    std::vector<bool> targets;
+
+    for (auto& entry : entries) {
+        const PCI_DEVICE_INFO& device = devices[entry.Index];
+        ParseCpuList(device.LocalCpus, local);
+        std::fill(perCpu.begin(), perCpu.end(), 0);
+
+        targets.clear();
+        for (uint32_t irq : entry.Irqs) {
+            const std::string* list = interrupts.GetAffinity(irq);
+            if (!list || !ParseCpuList(*list, affinity)) {
+                continue;
+            }
+            entry.HasAffinity = true;
+
+            bool remote = false;
+            if (targets.size() < affinity.size()) {
+                targets.resize(affinity.size());
+            }
+            for (size_t cpu = 0; cpu < affinity.size(); ++cpu) {
+                if (affinity[cpu]) {
+                    targets[cpu] = true;
+                    remote |= cpu >= local.size() || !local[cpu];
+                }
+            }
+
+            if (local.empty()) {
+                continue;
+            }
+            if (remote) {
+                ++entry.RemoteVectors;
+            }
+            else {
+                ++entry.LocalVectors;
+            }
+        }
+        entry.TargetCpus = FormatCpuList(targets);
+
+        for (uint32_t irq : entry.Irqs) {
+            const uint64_t* counts = interrupts.GetCounts(irq);
+            if (!counts) {
+                continue;
+            }
+            entry.HasCounts = true;
+            for (size_t i = 0; i < cpus.size(); ++i) {
+                perCpu[i] += counts[i];
+            }
+        }
+
+        serviced.clear();
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            if (!perCpu[i]) {
+                continue;
+            }
+            uint32_t cpu = cpus[i];
+            if (serviced.size() <= cpu) {
+                serviced.resize(cpu + 1);
+            }
+            serviced[cpu] = true;
+
+            if (local.empty()) {
+                continue;
+            }
+            if (cpu < local.size() && local[cpu]) {
+                entry.LocalInterrupts += perCpu[i];
+            }
+            else {
+                entry.RemoteInterrupts += perCpu[i];
+            }
+        }
+        entry.IrqCpus = FormatCpuList(serviced);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "pci_device_info.h"
+
+struct PCI_LOCALITY_ENTRY {
+    uint32_t Index;
+    std::vector<uint32_t> Irqs;
+    std::string TargetCpus;
+    uint32_t LocalVectors{ 0 };
+    uint32_t RemoteVectors{ 0 };
+    bool HasAffinity{ false };
+    std::string IrqCpus;
+    uint64_t LocalInterrupts{ 0 };
+    uint64_t RemoteInterrupts{ 0 };
+    bool HasCounts{ false };
+};
+
+class Proc_Interrupts {
+private:
+    std::vector<uint32_t> m_cpus;
+    std::vector<uint32_t> m_irqs;
+    std::vector<uint64_t> m_counts;
+    std::vector<uint8_t> m_found;
+    std::vector<std::string> m_affinity;
+
+public:
+    static constexpr const char* DefaultPath = "/proc/interrupts";
+
+    bool Load(const std::string& path, std::vector<uint32_t> irqs);
+    void Parse(std::string_view text);
+    void LoadAffinity(const std::string& irqRoot);
+    const uint64_t* GetCounts(uint32_t irq) const;
+    const std::string* GetAffinity(uint32_t irq) const;
+    const std::vector<uint32_t>& GetCpus() const { return m_cpus; }
+
+private:
+    void ParseHeader(std::string_view line);
+};
+
+class Irq_Locality {
+public:
+    static bool ParseCpuList(std::string_view text, std::vector<bool>& cpus);
+    static std::string FormatCpuList(const std::vector<bool>& cpus);
+    static void Build(const std::vector<PCI_DEVICE_INFO>& devices, const Proc_Interrupts& interrupts,
+        std::vector<PCI_LOCALITY_ENTRY>& entries);
+};
\ No newline at end of file
@@ -0,0 +1,127 @@
+#include "link_report.h"
+#include <algorithm>
+#include <iterator>
+#include "config_space.h"
+#include "../PCICommon/pci_config.h"
+
+//      , /,   :
+// 8b/10b  Gen1-2, 128b/130b  Gen3-5, FLIT 242/256  Gen6
+static constexpr double LaneBandwidth[] = { 0.0, 250.0, 500.0, 984.6, 1969.2, 3938.5, 7562.5 };
+
+double PCI_Link_Report::GetBandwidth(uint8_t speed, uint8_t width) {
+    if (speed >= std::size(LaneBandwidth)) {
+        return 0.0;
+    }
+    return LaneBandwidth[speed] * width;
+}
+
+//      (  PCI -> PCIe) Link Status   
+bool PCI_Link_Report::IsDownstreamPort(uint8_t portType) {
+    return portType == PCI_EXP_TYPE_ROOT_PORT || portType == PCI_EXP_TYPE_DOWNSTREAM || portType == PCI_EXP_TYPE_PCIE_BRIDGE;
+}
+
+//  ,      PCIe -> PCI  :
+//  Link Status      
+bool PCI_Link_Report::IsUpstreamPort(uint8_t portType) {
+    return portType == PCI_EXP_TYPE_ENDPOINT || portType == PCI_EXP_TYPE_LEG_END ||
+        portType == PCI_EXP_TYPE_UPSTREAM || portType == PCI_EXP_TYPE_PCI_BRIDGE;
+}
+
+//  -:       (    ),
+//    .     -   ,   .
+// VF   -     
+bool PCI_Link_Report::IsPointToPoint(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology, uint32_t port) const {
+    uint32_t first = PCI_Topology::None;
+    for (uint32_t child = topology.GetNode(port).FirstChild; child != PCI_Topology::None; child = topology.GetNode(child).NextSibling) {
+        if (!m_links[child].Present || devices[child].Virtual) {
+            continue;
+        }
+        if (!IsUpstreamPort(m_links[child].Link.PortType)) {
+            return false;
+        }
+        if (first == PCI_Topology::None) {
+            first = child;
+        }
+        else if (devices[child].Device != devices[first].Device) {
+            return false;
+        }
+    }
+    return first != PCI_Topology::None;
+}
+
+//   :  ,  , - -,   - 
+//    ,       -.   
+//   -   
+uint32_t PCI_Link_Report::FindPeer(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology, uint32_t index) const {
+    const PCI_TOPOLOGY_NODE& node = topology.GetNode(index);
+    uint8_t portType = m_links[index].Link.PortType;
+
+    if (IsUpstreamPort(portType)) {
+        uint32_t parent = node.Parent;
+        bool linked = parent != PCI_Topology::None && m_links[parent].Present && IsDownstreamPort(m_links[parent].Link.PortType) &&
+            IsPointToPoint(devices, topology, parent);
+        return linked ? parent : PCI_Topology::None;
+    }
+    if (!IsDownstreamPort(portType) || !IsPointToPoint(devices, topology, index)) {
+        return PCI_Topology::None;
+    }
+
+    for (uint32_t child = node.FirstChild; child != PCI_Topology::None; child = topology.GetNode(child).NextSibling) {
+        if (m_links[child].Present && !devices[child].Virtual) {
+            return child;
+        }
+    }
+    return PCI_Topology::None;
+}
+
+//   ,       .
+//             -
+//      
+void PCI_Link_Report::Build(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology) {
+    m_links.assign(devices.size(), {});
+    m_paths.clear();
+    m_degraded = 0;
+
+    for (size_t i = 0; i < devices.size(); ++i) {
+        PCI_Config_Space config(devices[i]);
+        PCI_LINK_STATE& state = m_links[i];
+        state.Present = config.GetLink(state.Link) &&
+            state.Link.PortType != PCI_EXP_TYPE_RC_END && state.Link.PortType != PCI_EXP_TYPE_RC_EC;
+    }
+
+    for (uint32_t i = 0; i < m_links.size(); ++i) {
+        PCI_LINK_STATE& state = m_links[i];
+        if (!state.Present) {
+            continue;
+        }
+
+        state.CapableSpeed = state.Link.MaxSpeed;
+        state.CapableWidth = state.Link.MaxWidth;
+        uint32_t peer = FindPeer(devices, topology, i);
+        if (peer != PCI_Topology::None) {
+            state.CapableSpeed = std::min(state.CapableSpeed, m_links[peer].Link.MaxSpeed);
+            state.CapableWidth = std::min(state.CapableWidth, m_links[peer].Link.MaxWidth);
+        }
+
+        state.Degraded = state.Link.Speed < state.CapableSpeed || state.Link.Width < state.CapableWidth;
+        m_degraded += state.Degraded;
+    }
+
+    for (uint32_t i = 0; i < m_links.size(); ++i) {
+        const PCI_LINK_STATE& state = m_links[i];
+        if (!state.Present || (devices[i].HeaderType & PCI_HEADER_TYPE_MASK) != PCI_HEADER_TYPE_NORMAL) {
+            continue;
+        }
+
+        PCI_LINK_PATH path{ i, i, GetBandwidth(state.CapableSpeed, state.CapableWidth), GetBandwidth(state.Link.Speed, state.Link.Width) };
+        for (uint32_t parent = topology.GetNode(i).Parent; parent != PCI_Topology::None; parent = topology.GetNode(parent).Parent) {
+            const PCI_LINK_STATE& upstream = m_links[parent];
+            double bandwidth = upstream.Present ? GetBandwidth(upstream.Link.Speed, upstream.Link.Width) : 0.0;
+            if (upstream.Present && bandwidth < path.AvailableBandwidth) {
+                path.AvailableBandwidth = bandwidth;
+                path.Bottleneck = parent;
+            }
+        }
+        m_paths.push_back(path);
+    }
+}
\ No newline at end of file
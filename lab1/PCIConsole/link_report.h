@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pci_device_info.h"
+#include "pci_link.h"
+#include "pci_topology.h"
+
+struct PCI_LINK_STATE {
+    bool Present{ false };
+    bool Degraded{ false };
+    PCI_LINK Link{};
+    uint8_t CapableSpeed{ 0 };
+    uint8_t CapableWidth{ 0 };
+};
+
+struct PCI_LINK_PATH {
+    uint32_t Index;
+    uint32_t Bottleneck;
+    double CapableBandwidth;
+    double AvailableBandwidth;
+};
+
+class PCI_Link_Report {
+private:
+    std::vector<PCI_LINK_STATE> m_links;
+    std::vector<PCI_LINK_PATH> m_paths;
+    size_t m_degraded{ 0 };
+
+public:
+    void Build(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology);
+
+    size_t Size() const { return m_links.size(); }
+    const PCI_LINK_STATE& GetLink(uint32_t index) const { return m_links[index]; }
+    const std::vector<PCI_LINK_PATH>& GetPaths() const { return m_paths; }
+    size_t GetDegradedCount() const { return m_degraded; }
+
+    static double GetBandwidth(uint8_t speed, uint8_t width);
+    static bool IsDownstreamPort(uint8_t portType);
+    static bool IsUpstreamPort(uint8_t portType);
+
+private:
+    bool IsPointToPoint(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology, uint32_t port) const;
+    uint32_t FindPeer(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology, uint32_t index) const;
+};
\ No newline at end of file
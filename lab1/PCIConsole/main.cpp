@@ -1,7 +1,7 @@
 ﻿#define _CRT_SECURE_NO_WARNINGS
 #include "app.h"
 
-int main() {
+int main(int argc, char* argv[]) {
     Application app;
-    return app.Run();
+    return app.Run(argc, argv);
 }
\ No newline at end of file
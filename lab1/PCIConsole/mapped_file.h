@@ -0,0 +1,30 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class Mapped_File {
+private:
+    const uint8_t* m_data{ nullptr };
+    size_t m_size{ 0 };
+#ifdef _WIN32
+    void* m_hFile{ nullptr };
+    void* m_hMapping{ nullptr };
+#else
+    int m_fd{ -1 };
+#endif
+
+public:
+    Mapped_File() = default;
+    ~Mapped_File();
+
+    Mapped_File(const Mapped_File&) = delete;
+    Mapped_File& operator=(const Mapped_File&) = delete;
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const;
+
+    const uint8_t* Data() const { return m_data; }
+    size_t Size() const { return m_size; }
+};
\ No newline at end of file
@@ -0,0 +1,9 @@
+#pragma once
+#include <cstdint>
+
+struct PCI_AER_COUNTERS {
+    uint64_t Correctable;
+    uint64_t NonFatal;
+    uint64_t Fatal;
+    bool StatusOnly;
+};
\ No newline at end of file
@@ -0,0 +1,87 @@
+#include "pci_backend.h"
+#include <iterator>
+#include "config_space.h"
+#ifdef _WIN32
+#include "driver_backend.h"
+#else
+#include "sysfs_backend.h"
+#endif
+
+// ,    ,      (  )   
+bool PCI_Backend::EnumerateBatches(const PCI_BATCH_CALLBACK& onBatch) {
+    std::vector<PCI_DEVICE_INFO> devices;
+    std::vector<PCI_DEVICE_INFO> batch;
+    Enumerate(devices);
+
+    for (size_t begin = 0; begin < devices.size();) {
+        size_t end = begin + 1;
+        while (end < devices.size() && devices[end].Segment == devices[begin].Segment &&
+            devices[end].Bus == devices[begin].Bus) {
+            ++end;
+        }
+
+        batch.assign(std::make_move_iterator(devices.begin() + begin), std::make_move_iterator(devices.begin() + end));
+        if (!onBatch(batch)) {
+            return false;
+        }
+        begin = end;
+    }
+    return true;
+}
+
+//      
+bool PCI_Backend::ReadConfigSpace(const PCI_DEVICE_INFO&, std::vector<uint8_t>& config) {
+    config.clear();
+    return false;
+}
+
+// ,      ,    
+bool PCI_Backend::Matches(const PCI_DEVICE_INFO& device) const {
+    uint32_t id = PCI_FILTER_ID(device.VendorID, device.DeviceID);
+    uint32_t classRev = (static_cast<uint32_t>(device.BaseClass) << 24) | (device.SubClass << 16) | (device.ProgIF << 8) | device.Revision;
+    return PciFilterMatch(&m_filter, device.Bus, id, classRev) != 0;
+}
+
+//  BAR   ,   
+bool PCI_Backend::ReadBarSizes(const PCI_DEVICE_INFO&, PCI_BAR_SIZES& sizes) {
+    sizes.fill(0);
+    return false;
+}
+
+//       AER.      
+//     ,       StatusOnly:
+//     ,    .    
+bool PCI_Backend::ReadAerCounters(const PCI_DEVICE_INFO& device, PCI_AER_COUNTERS& counters) {
+    counters = {};
+    if (!ReadConfigSpace(device, m_aerConfig)) {
+        return false;
+    }
+
+    PCI_Config_Space config(m_aerConfig.data(), static_cast<uint16_t>(m_aerConfig.size()));
+    uint16_t aer = config.FindExtendedCapability(PCI_EXT_CAP_ID_AER);
+    if (!aer) {
+        return false;
+    }
+
+    uint32_t uncorrectable = config.Read32(aer + PCI_AER_UNCOR_STATUS);
+    uint32_t severity = config.Read32(aer + PCI_AER_UNCOR_SEVERITY);
+    counters.Correctable = config.Read32(aer + PCI_AER_COR_STATUS);
+    counters.NonFatal = uncorrectable & ~severity;
+    counters.Fatal = uncorrectable & severity;
+    counters.StatusOnly = true;
+    return true;
+}
+
+// NUMA-      
+bool PCI_Backend::ReadLocality(PCI_DEVICE_INFO&, std::vector<uint32_t>& irqs) {
+    irqs.clear();
+    return false;
+}
+
+std::unique_ptr<PCI_Backend> PCI_Backend::CreateDefault() {
+#ifdef _WIN32
+    return std::make_unique<Driver_Backend>();
+#else
+    return std::make_unique<Sysfs_Backend>();
+#endif
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "pci_device_info.h"
+#include "pci_bar.h"
+#include "pci_aer.h"
+#include "scan_stats.h"
+#include "../PCICommon/pci_filter.h"
+
+using PCI_BATCH_CALLBACK = std::function<bool(std::vector<PCI_DEVICE_INFO>& batch)>;
+
+class PCI_Backend {
+protected:
+    bool m_captureConfig{ false };
+    PCI_FILTER m_filter{};
+    Scan_Stats* m_stats{ nullptr };
+    std::vector<uint8_t> m_aerConfig;
+
+public:
+    virtual ~PCI_Backend() = default;
+
+    virtual bool Open() = 0;
+    virtual void Close() = 0;
+    virtual bool IsOpen() const = 0;
+    virtual void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) = 0;
+    virtual bool EnumerateBatches(const PCI_BATCH_CALLBACK& onBatch);
+    virtual bool ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config);
+    virtual bool ReadBarSizes(const PCI_DEVICE_INFO& device, PCI_BAR_SIZES& sizes);
+    virtual bool ReadAerCounters(const PCI_DEVICE_INFO& device, PCI_AER_COUNTERS& counters);
+    virtual bool ReadLocality(PCI_DEVICE_INFO& device, std::vector<uint32_t>& irqs);
+    virtual const char* GetName() const = 0;
+
+    void SetConfigCapture(bool enabled) { m_captureConfig = enabled; }
+    bool IsConfigCaptureEnabled() const { return m_captureConfig; }
+    void SetFilter(const PCI_FILTER& filter) { m_filter = filter; }
+    const PCI_FILTER& GetFilter() const { return m_filter; }
+    void SetStats(Scan_Stats* stats) { m_stats = stats; }
+    bool Matches(const PCI_DEVICE_INFO& device) const;
+
+    static std::unique_ptr<PCI_Backend> CreateDefault();
+};
\ No newline at end of file
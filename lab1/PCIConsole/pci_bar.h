@@ -0,0 +1,20 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include "../PCICommon/pci_config.h"
+
+enum class PCI_BAR_TYPE {
+    Memory32,
+    Memory64,
+    Io
+};
+
+struct PCI_BAR {
+    uint8_t Index;
+    PCI_BAR_TYPE Type;
+    bool Prefetchable;
+    uint64_t Address;
+    uint64_t Size;
+};
+
+using PCI_BAR_SIZES = std::array<uint64_t, PCI_BAR_COUNT_NORMAL>;
\ No newline at end of file
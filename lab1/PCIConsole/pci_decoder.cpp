@@ -0,0 +1,149 @@
+#include "pci_decoder.h"
+#include "../PCICommon/pci_config.h"
+
+//    little-endian
+uint16_t PCI_Config_Decoder::Read16(const uint8_t* config, size_t offset) {
+    return static_cast<uint16_t>(config[offset] | (config[offset + 1] << 8));
+}
+
+uint32_t PCI_Config_Decoder::Read32(const uint8_t* config, size_t offset) {
+    return static_cast<uint32_t>(Read16(config, offset)) | (static_cast<uint32_t>(Read16(config, offset + 2)) << 16);
+}
+
+//   64- ;  BDF  
+bool PCI_Config_Decoder::DecodeHeader(const uint8_t* config, size_t size, PCI_DEVICE_INFO& device) {
+    if (size < HeaderSize) {
+        return false;
+    }
+
+    uint32_t id = Read32(config, PCI_CFG_ID);
+    if (PCI_ID_VENDOR(id) == PCI_INVALID_VENDOR_ID) {
+        return false;
+    }
+
+    uint32_t classRev = Read32(config, PCI_CFG_CLASS_REV);
+
+    device.VendorID = PCI_ID_VENDOR(id);
+    device.DeviceID = PCI_ID_DEVICE(id);
+    device.Revision = PCI_CLASS_REVISION(classRev);
+    device.ProgIF = PCI_CLASS_PROG_IF(classRev);
+    device.SubClass = PCI_CLASS_SUB(classRev);
+    device.BaseClass = PCI_CLASS_BASE(classRev);
+    device.HeaderType = PCI_HEADER_TYPE(Read32(config, PCI_CFG_HEADER));
+
+    if ((device.HeaderType & PCI_HEADER_TYPE_MASK) == PCI_HEADER_TYPE_NORMAL) {
+        uint32_t subsystem = Read32(config, PCI_CFG_SUBSYSTEM);
+        device.SubsystemVendorID = PCI_ID_VENDOR(subsystem);
+        device.SubsystemID = PCI_ID_DEVICE(subsystem);
+    }
+    else {
+        device.SubsystemVendorID = 0;
+        device.SubsystemID = 0;
+    }
+
+    //     PCI  CardBus    
+    device.SecondaryBus = 0;
+    device.SubordinateBus = 0;
+    if ((device.HeaderType & PCI_HEADER_TYPE_MASK) != PCI_HEADER_TYPE_NORMAL) {
+        uint32_t busNumbers = Read32(config, PCI_CFG_BUS_NUMBERS);
+        device.SecondaryBus = PCI_BUS_SECONDARY(busNumbers);
+        device.SubordinateBus = PCI_BUS_SUBORDINATE(busNumbers);
+    }
+
+    return true;
+}
+
+void PCI_Config_Decoder::DecodeWireRecord(const PCI_WIRE_RECORD& record, PCI_DEVICE_INFO& device) {
+    device.Bus = record.Bus;
+    device.Device = record.Device;
+    device.Function = record.Function;
+    device.HeaderType = record.HeaderType;
+    device.VendorID = record.VendorID;
+    device.DeviceID = record.DeviceID;
+    device.BaseClass = record.BaseClass;
+    device.SubClass = record.SubClass;
+    device.ProgIF = record.ProgIF;
+    device.Revision = record.Revision;
+    device.SubsystemVendorID = record.SubsystemVendorID;
+    device.SubsystemID = record.SubsystemID;
+    device.Virtual = (record.Flags & PCI_WIRE_RECORD_VIRTUAL) != 0;
+    device.PhysicalFunction = device.Virtual ? record.PhysicalFunction : 0;
+}
+
+//  VF Vendor ID  Device ID   0xFFFF:    PF
+//    capability SR-IOV,    
+bool PCI_Config_Decoder::DecodeVirtualFunction(const uint8_t* config, size_t size, uint32_t idDword, uint16_t physicalFunction,
+    PCI_DEVICE_INFO& device) {
+    if (size < HeaderSize) {
+        return false;
+    }
+
+    uint32_t classRev = Read32(config, PCI_CFG_CLASS_REV);
+    uint32_t subsystem = Read32(config, PCI_CFG_SUBSYSTEM);
+
+    device.VendorID = PCI_ID_VENDOR(idDword);
+    device.DeviceID = PCI_ID_DEVICE(idDword);
+    device.Revision = PCI_CLASS_REVISION(classRev);
+    device.ProgIF = PCI_CLASS_PROG_IF(classRev);
+    device.SubClass = PCI_CLASS_SUB(classRev);
+    device.BaseClass = PCI_CLASS_BASE(classRev);
+    device.HeaderType = PCI_HEADER_TYPE_NORMAL;
+    device.SubsystemVendorID = PCI_ID_VENDOR(subsystem);
+    device.SubsystemID = PCI_ID_DEVICE(subsystem);
+    device.SecondaryBus = 0;
+    device.SubordinateBus = 0;
+    device.Virtual = true;
+    device.PhysicalFunction = physicalFunction;
+    return true;
+}
+
+//      ,  -  :  
+// 0xFFFFFFFF  ,     
+size_t PCI_Config_Decoder::DecodeBars(const uint8_t* config, size_t size, const PCI_BAR_SIZES* sizes, std::vector<PCI_BAR>& bars) {
+    bars.clear();
+    if (size < HeaderSize) {
+        return 0;
+    }
+
+    uint8_t headerType = PCI_HEADER_TYPE(Read32(config, PCI_CFG_HEADER)) & PCI_HEADER_TYPE_MASK;
+    uint8_t count = 0;
+    if (headerType == PCI_HEADER_TYPE_NORMAL) {
+        count = PCI_BAR_COUNT_NORMAL;
+    }
+    else if (headerType == PCI_HEADER_TYPE_BRIDGE) {
+        count = PCI_BAR_COUNT_BRIDGE;
+    }
+
+    for (uint8_t index = 0; index < count; ++index) {
+        uint32_t low = Read32(config, PCI_CFG_BAR0 + index * 4);
+        uint64_t barSize = sizes ? (*sizes)[index] : 0;
+        if (low == 0xFFFFFFFF || (low == 0 && barSize == 0)) {
+            continue;
+        }
+
+        PCI_BAR bar{};
+        bar.Index = index;
+        bar.Size = barSize;
+
+        if (low & PCI_BAR_SPACE_IO) {
+            bar.Type = PCI_BAR_TYPE::Io;
+            bar.Address = low & PCI_BAR_IO_ADDR_MASK;
+        }
+        else {
+            bar.Prefetchable = (low & PCI_BAR_MEM_PREFETCH) != 0;
+            bar.Address = low & PCI_BAR_MEM_ADDR_MASK;
+            bar.Type = PCI_BAR_TYPE::Memory32;
+
+            // 64- BAR        
+            if ((low & PCI_BAR_MEM_TYPE_MASK) == PCI_BAR_MEM_TYPE_64 && index + 1 < count) {
+                bar.Type = PCI_BAR_TYPE::Memory64;
+                bar.Address |= static_cast<uint64_t>(Read32(config, PCI_CFG_BAR0 + (index + 1) * 4)) << 32;
+                ++index;
+            }
+        }
+
+        bars.push_back(bar);
+    }
+
+    return bars.size();
+}
\ No newline at end of file
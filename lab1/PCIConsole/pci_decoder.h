@@ -0,0 +1,21 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pci_device_info.h"
+#include "pci_bar.h"
+#include "../PCICommon/pci_wire.h"
+
+class PCI_Config_Decoder {
+public:
+    static constexpr size_t HeaderSize = 64;
+
+    static uint16_t Read16(const uint8_t* config, size_t offset);
+    static uint32_t Read32(const uint8_t* config, size_t offset);
+
+    static bool DecodeHeader(const uint8_t* config, size_t size, PCI_DEVICE_INFO& device);
+    static void DecodeWireRecord(const PCI_WIRE_RECORD& record, PCI_DEVICE_INFO& device);
+    static bool DecodeVirtualFunction(const uint8_t* config, size_t size, uint32_t idDword, uint16_t physicalFunction,
+        PCI_DEVICE_INFO& device);
+    static size_t DecodeBars(const uint8_t* config, size_t size, const PCI_BAR_SIZES* sizes, std::vector<PCI_BAR>& bars);
+};
\ No newline at end of file
@@ -0,0 +1,118 @@
+#include "pci_device_index.h"
+#include <algorithm>
+#include <bit>
+#include <numeric>
+#include <tuple>
+
+//           .
+//  ,     :  
+//   ,     .      devices
+void PCI_Device_Index::Build(const std::vector<PCI_DEVICE_INFO>& devices) {
+    uint32_t count = static_cast<uint32_t>(devices.size());
+
+    m_keys.resize(count);
+    m_ids.resize(count);
+    m_classes.resize(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        const PCI_DEVICE_INFO& device = devices[i];
+        m_keys[i] = device.GetKey();
+        m_ids[i] = MakeId(device.VendorID, device.DeviceID);
+        m_classes[i] = (static_cast<uint32_t>(device.BaseClass) << 24) | (device.SubClass << 16) | (device.ProgIF << 8) | device.Revision;
+    }
+
+    //         -    
+    m_byKey.resize(count);
+    std::iota(m_byKey.begin(), m_byKey.end(), 0u);
+    auto byKey = [&](uint32_t a, uint32_t b) { return m_keys[a] < m_keys[b]; };
+    if (!std::is_sorted(m_byKey.begin(), m_byKey.end(), byKey)) {
+        std::sort(m_byKey.begin(), m_byKey.end(), byKey);
+    }
+
+    //     ,    
+    size_t capacity = std::bit_ceil(std::max<size_t>(16, static_cast<size_t>(count) * 2));
+    size_t mask = capacity - 1;
+    m_slotShift = 64 - static_cast<unsigned>(std::countr_zero(capacity));
+    m_slots.assign(capacity, None);
+    for (uint32_t i = 0; i < count; ++i) {
+        size_t slot = GetSlot(m_keys[i]);
+        while (m_slots[slot] != None) {
+            slot = (slot + 1) & mask;
+        }
+        m_slots[slot] = i;
+    }
+
+    // Vendor ID    :   
+    //    
+    m_byId = m_byKey;
+    std::sort(m_byId.begin(), m_byId.end(), [&](uint32_t a, uint32_t b) {
+        return std::tie(m_ids[a], m_keys[a]) < std::tie(m_ids[b], m_keys[b]);
+    });
+    m_idRuns.clear();
+    for (uint32_t position = 0; position < count; ++position) {
+        uint32_t id = m_ids[m_byId[position]];
+        if (m_idRuns.empty() || m_idRuns.back().Id != id) {
+            m_idRuns.push_back({ id, position, 0 });
+        }
+        ++m_idRuns.back().Count;
+    }
+
+    //     ;   -  
+    m_classStart.fill(0);
+    for (uint32_t i = 0; i < count; ++i) {
+        ++m_classStart[GetBaseClass(i) + 1];
+    }
+    std::partial_sum(m_classStart.begin(), m_classStart.end(), m_classStart.begin());
+
+    std::array<uint32_t, 256> next;
+    std::copy(m_classStart.begin(), m_classStart.end() - 1, next.begin());
+    m_byClass.resize(count);
+    for (uint32_t index : m_byKey) {
+        m_byClass[next[GetBaseClass(index)]++] = index;
+    }
+}
+
+//  :      
+size_t PCI_Device_Index::GetSlot(uint32_t key) const {
+    return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> m_slotShift);
+}
+
+uint32_t PCI_Device_Index::Find(uint32_t key) const {
+    if (m_slots.empty()) {
+        return None;
+    }
+
+    size_t mask = m_slots.size() - 1;
+    for (size_t slot = GetSlot(key);; slot = (slot + 1) & mask) {
+        uint32_t index = m_slots[slot];
+        if (index == None || m_keys[index] == key) {
+            return index;
+        }
+    }
+}
+
+std::span<const uint32_t> PCI_Device_Index::FindById(uint16_t vendorId, uint16_t deviceId) const {
+    uint32_t id = MakeId(vendorId, deviceId);
+    return GetRuns(id, id);
+}
+
+std::span<const uint32_t> PCI_Device_Index::FindVendor(uint16_t vendorId) const {
+    return GetRuns(MakeId(vendorId, 0), MakeId(vendorId, UINT16_MAX));
+}
+
+std::span<const uint32_t> PCI_Device_Index::FindClass(uint8_t baseClass) const {
+    return std::span<const uint32_t>(m_byClass).subspan(m_classStart[baseClass], m_classStart[baseClass + 1] - m_classStart[baseClass]);
+}
+
+//     [first, last]   m_byId 
+std::span<const uint32_t> PCI_Device_Index::GetRuns(uint32_t first, uint32_t last) const {
+    auto begin = std::lower_bound(m_idRuns.begin(), m_idRuns.end(), first,
+        [](const PCI_ID_RUN& run, uint32_t id) { return run.Id < id; });
+    auto end = std::upper_bound(begin, m_idRuns.end(), last,
+        [](uint32_t id, const PCI_ID_RUN& run) { return id < run.Id; });
+    if (begin == end) {
+        return {};
+    }
+
+    uint32_t size = (end - 1)->Begin + (end - 1)->Count - begin->Begin;
+    return std::span<const uint32_t>(m_byId).subspan(begin->Begin, size);
+}
\ No newline at end of file
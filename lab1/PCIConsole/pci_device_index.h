@@ -0,0 +1,52 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "pci_device_info.h"
+
+struct PCI_ID_RUN {
+    uint32_t Id;
+    uint32_t Begin;
+    uint32_t Count;
+};
+
+class PCI_Device_Index {
+private:
+    std::vector<uint32_t> m_keys;
+    std::vector<uint32_t> m_ids;
+    std::vector<uint32_t> m_classes;
+    std::vector<uint32_t> m_slots;
+    unsigned m_slotShift{ 64 };
+    std::vector<uint32_t> m_byKey;
+    std::vector<uint32_t> m_byId;
+    std::vector<PCI_ID_RUN> m_idRuns;
+    std::vector<uint32_t> m_byClass;
+    std::array<uint32_t, 257> m_classStart{};
+
+public:
+    static constexpr uint32_t None = UINT32_MAX;
+
+    void Build(const std::vector<PCI_DEVICE_INFO>& devices);
+
+    size_t Size() const { return m_keys.size(); }
+    uint32_t GetKey(uint32_t index) const { return m_keys[index]; }
+    uint16_t GetVendorID(uint32_t index) const { return static_cast<uint16_t>(m_ids[index] >> 16); }
+    uint16_t GetDeviceID(uint32_t index) const { return static_cast<uint16_t>(m_ids[index]); }
+    uint8_t GetBaseClass(uint32_t index) const { return static_cast<uint8_t>(m_classes[index] >> 24); }
+    uint32_t GetClassDword(uint32_t index) const { return m_classes[index]; }
+
+    uint32_t Find(uint32_t key) const;
+    std::span<const uint32_t> FindById(uint16_t vendorId, uint16_t deviceId) const;
+    std::span<const uint32_t> FindVendor(uint16_t vendorId) const;
+    std::span<const uint32_t> FindClass(uint8_t baseClass) const;
+    std::span<const uint32_t> GetKeyOrder() const { return m_byKey; }
+    const std::vector<PCI_ID_RUN>& GetIdRuns() const { return m_idRuns; }
+
+    static uint32_t MakeId(uint16_t vendorId, uint16_t deviceId) { return (static_cast<uint32_t>(vendorId) << 16) | deviceId; }
+
+private:
+    size_t GetSlot(uint32_t key) const;
+    std::span<const uint32_t> GetRuns(uint32_t first, uint32_t last) const;
+};
\ No newline at end of file
@@ -1,23 +1,46 @@
 #pragma once
-#include <windows.h>
+#include <cstdint>
 #include <string>
 #include <format>
 
-#define IOCTL_PCI_GET_DEVICES CTL_CODE(FILE_DEVICE_UNKNOWN, 0x800, METHOD_BUFFERED, FILE_ANY_ACCESS)
-
 struct PCI_DEVICE_INFO {
-    UCHAR Bus;
-    UCHAR Device;
-    UCHAR Function;
-    USHORT VendorID;
-    USHORT DeviceID;
-    UCHAR BaseClass;
-    UCHAR SubClass;
-    UCHAR Revision;
-    char Description[64];
+    uint16_t Segment{ 0 };
+    uint8_t Bus;
+    uint8_t Device;
+    uint8_t Function;
+    uint8_t HeaderType;
+    uint16_t VendorID;
+    uint16_t DeviceID;
+    uint8_t BaseClass;
+    uint8_t SubClass;
+    uint8_t ProgIF;
+    uint8_t Revision;
+    uint16_t SubsystemVendorID;
+    uint16_t SubsystemID;
+    uint8_t SecondaryBus{ 0 };
+    uint8_t SubordinateBus{ 0 };
+    bool Virtual{ false };
+    uint16_t PhysicalFunction{ 0 };
+    int16_t NumaNode{ -1 };
+    uint16_t MsiVectors{ 0 };
+    std::string LocalCpus;
+    std::string Description;
+    const uint8_t* Config{ nullptr };
+    uint16_t ConfigSize{ 0 };
+
+    uint32_t GetKey() const {
+        return (static_cast<uint32_t>(Segment) << 16) | (static_cast<uint32_t>(Bus) << 8) | (static_cast<uint32_t>(Device) << 3) | Function;
+    }
+
+    uint64_t GetFingerprint() const {
+        uint64_t ids = (static_cast<uint64_t>(DeviceID) << 16) | VendorID;
+        uint64_t classRev = (static_cast<uint64_t>(BaseClass) << 24) | (SubClass << 16) | (ProgIF << 8) | Revision;
+        uint64_t subsystem = (static_cast<uint64_t>(SubsystemID) << 16) | SubsystemVendorID;
+        return ((ids << 32) | classRev) ^ ((subsystem | (static_cast<uint64_t>(HeaderType) << 32)) * 0x9E3779B97F4A7C15ull);
+    }
 
     std::string GetLocation() const {
-        return std::format("{:02X}:{:02X}.{:X}", Bus, Device, Function);
+        return std::format("{:04X}:{:02X}:{:02X}.{:X}", Segment, Bus, Device, Function);
     }
 
     std::string GetVendorDeviceID() const {
@@ -27,9 +50,4 @@ struct PCI_DEVICE_INFO {
     std::string GetClassCodes() const {
         return std::format("{:02X}:{:02X}", BaseClass, SubClass);
     }
-};
-
-struct PCI_DEVICE_LIST {
-    ULONG NumberOfDevices;
-    PCI_DEVICE_INFO Devices[32];
 };
\ No newline at end of file
@@ -0,0 +1,324 @@
+#include "pci_ids_db.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <format>
+#include <tuple>
+#include <vector>
+
+static uint64_t SplitMix(uint64_t x) {
+    x ^= 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+//     64 ,      
+//    :    .   ,
+//     .          
+static uint64_t MixKey(PCI_IDS_KIND kind, uint64_t key) {
+    return SplitMix(SplitMix(key) ^ static_cast<uint64_t>(kind));
+}
+
+static uint32_t GetSlot(uint64_t hash, uint32_t displacement, uint32_t slotCount) {
+    uint64_t h1 = hash & 0xFFFFFFFF;
+    uint64_t h2 = (hash >> 32) | 1;
+    return static_cast<uint32_t>((h1 + displacement * h2) % slotCount);
+}
+
+static uint32_t GetBucket(uint64_t hash, uint32_t bucketCount) {
+    return static_cast<uint32_t>(((hash >> 17) ^ (hash >> 47)) % bucketCount);
+}
+
+static size_t GetSlotsOffset(uint32_t bucketCount) {
+    size_t offset = sizeof(PCI_IDS_HEADER) + bucketCount * sizeof(uint32_t);
+    return (offset + 7) & ~static_cast<size_t>(7);
+}
+
+bool PCI_Ids_Database::Open(const std::string& path) {
+    Close();
+
+    if (!m_file.Open(path)) {
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const PCI_IDS_HEADER*>(m_file.Data());
+    if (m_file.Size() < sizeof(PCI_IDS_HEADER) || header->Magic != Magic || header->Version != Version ||
+        header->BucketCount == 0 || header->SlotCount == 0) {
+        m_file.Close();
+        return false;
+    }
+
+    size_t slotsOffset = GetSlotsOffset(header->BucketCount);
+    size_t stringsOffset = slotsOffset + static_cast<size_t>(header->SlotCount) * sizeof(PCI_IDS_ENTRY);
+    if (stringsOffset + header->StringsSize > m_file.Size() || header->StringsSize == 0 ||
+        m_file.Data()[stringsOffset + header->StringsSize - 1] != '\0') {
+        m_file.Close();
+        return false;
+    }
+
+    m_header = header;
+    m_displacements = reinterpret_cast<const uint32_t*>(m_file.Data() + sizeof(PCI_IDS_HEADER));
+    m_slots = reinterpret_cast<const PCI_IDS_ENTRY*>(m_file.Data() + slotsOffset);
+    m_strings = reinterpret_cast<const char*>(m_file.Data() + stringsOffset);
+    return true;
+}
+
+void PCI_Ids_Database::Close() {
+    m_header = nullptr;
+    m_displacements = nullptr;
+    m_slots = nullptr;
+    m_strings = nullptr;
+    m_file.Close();
+}
+
+bool PCI_Ids_Database::IsOpen() const {
+    return m_header != nullptr;
+}
+
+uint32_t PCI_Ids_Database::GetEntryCount() const {
+    return m_header ? m_header->EntryCount : 0;
+}
+
+const char* PCI_Ids_Database::FindVendor(uint16_t vendor) const {
+    return Find(PCI_IDS_VENDOR, vendor);
+}
+
+const char* PCI_Ids_Database::FindDevice(uint16_t vendor, uint16_t device) const {
+    return Find(PCI_IDS_DEVICE, (static_cast<uint64_t>(vendor) << 16) | device);
+}
+
+const char* PCI_Ids_Database::FindSubsystem(uint16_t vendor, uint16_t device, uint16_t subVendor, uint16_t subDevice) const {
+    return Find(PCI_IDS_SUBSYSTEM, (static_cast<uint64_t>(vendor) << 48) | (static_cast<uint64_t>(device) << 32) |
+        (static_cast<uint64_t>(subVendor) << 16) | subDevice);
+}
+
+//        0xFFFF,      
+const char* PCI_Ids_Database::FindClass(uint8_t baseClass) const {
+    return Find(PCI_IDS_CLASS, (static_cast<uint64_t>(baseClass) << 16) | 0xFFFF);
+}
+
+const char* PCI_Ids_Database::FindSubClass(uint8_t baseClass, uint8_t subClass) const {
+    return Find(PCI_IDS_CLASS, (static_cast<uint64_t>(baseClass) << 16) | subClass);
+}
+
+//   :   ,      
+const char* PCI_Ids_Database::Find(PCI_IDS_KIND kind, uint64_t key) const {
+    if (!m_header) {
+        return nullptr;
+    }
+
+    uint64_t hash = MixKey(kind, key);
+    uint32_t displacement = m_displacements[GetBucket(hash, m_header->BucketCount)];
+    const PCI_IDS_ENTRY& entry = m_slots[GetSlot(hash, displacement, m_header->SlotCount)];
+
+    if (entry.Kind != kind || entry.Key != key || entry.NameOffset >= m_header->StringsSize) {
+        return nullptr;
+    }
+    return m_strings + entry.NameOffset;
+}
+
+struct PCI_IDS_SOURCE_ENTRY {
+    PCI_IDS_KIND Kind;
+    uint64_t Key;
+    uint32_t NameOffset;
+    uint64_t Hash;
+};
+
+//   pci.ids: //    "C xx"
+static bool ParseIdsFile(const std::string& path, std::vector<PCI_IDS_SOURCE_ENTRY>& entries, std::string& strings, std::string& err) {
+    std::ifstream in(path);
+    if (!in) {
+        err = std::format("Cannot open {}", path);
+        return false;
+    }
+
+    std::string line;
+    unsigned vendor = 0, device = 0, baseClass = 0;
+    bool inClasses = false, haveVendor = false, haveDevice = false;
+
+    auto addEntry = [&](PCI_IDS_KIND kind, uint64_t key, const std::string& name) {
+        entries.push_back({ kind, key, static_cast<uint32_t>(strings.size()), 0 });
+        strings.append(name);
+        strings.push_back('\0');
+    };
+
+    while (std::getline(in, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+
+        size_t tabs = line.find_first_not_of('\t');
+        size_t split = line.find("  ", tabs);
+        if (tabs == std::string::npos || split == std::string::npos) {
+            continue;
+        }
+        std::string id = line.substr(tabs, split - tabs);
+        std::string name = line.substr(split + 2);
+        unsigned a = 0, b = 0;
+
+        if (tabs == 0) {
+            inClasses = (id.size() > 2 && id[0] == 'C' && id[1] == ' ');
+            if (inClasses && std::sscanf(id.c_str() + 2, "%x", &baseClass) == 1) {
+                addEntry(PCI_IDS_CLASS, (static_cast<uint64_t>(baseClass) << 16) | 0xFFFF, name);
+                continue;
+            }
+            haveVendor = !inClasses && id.size() == 4 && std::sscanf(id.c_str(), "%x", &vendor) == 1;
+            haveDevice = false;
+            if (haveVendor) {
+                addEntry(PCI_IDS_VENDOR, vendor, name);
+            }
+        }
+        else if (tabs == 1 && inClasses) {
+            if (std::sscanf(id.c_str(), "%x", &a) == 1) {
+                addEntry(PCI_IDS_CLASS, (static_cast<uint64_t>(baseClass) << 16) | a, name);
+            }
+        }
+        else if (tabs == 1 && haveVendor) {
+            haveDevice = std::sscanf(id.c_str(), "%x", &device) == 1;
+            if (haveDevice) {
+                addEntry(PCI_IDS_DEVICE, (static_cast<uint64_t>(vendor) << 16) | device, name);
+            }
+        }
+        else if (tabs == 2 && haveDevice && std::sscanf(id.c_str(), "%x %x", &a, &b) == 2) {
+            addEntry(PCI_IDS_SUBSYSTEM, (static_cast<uint64_t>(vendor) << 48) | (static_cast<uint64_t>(device) << 32) |
+                (static_cast<uint64_t>(a) << 16) | b, name);
+        }
+    }
+
+    //  :   
+    std::stable_sort(entries.begin(), entries.end(), [](const PCI_IDS_SOURCE_ENTRY& x, const PCI_IDS_SOURCE_ENTRY& y) {
+        return std::tie(x.Kind, x.Key) < std::tie(y.Kind, y.Key);
+    });
+    entries.erase(std::unique(entries.begin(), entries.end(), [](const PCI_IDS_SOURCE_ENTRY& x, const PCI_IDS_SOURCE_ENTRY& y) {
+        return x.Kind == y.Kind && x.Key == y.Key;
+    }), entries.end());
+
+    if (entries.empty()) {
+        err = std::format("No entries found in {}", path);
+        return false;
+    }
+    return true;
+}
+
+//     "hash and displace":     ,
+//    ,         
+static bool BuildPerfectHash(const std::vector<PCI_IDS_SOURCE_ENTRY>& entries, uint32_t bucketCount, uint32_t slotCount,
+    std::vector<uint32_t>& displacements, std::vector<PCI_IDS_ENTRY>& slots) {
+    constexpr uint32_t maxDisplacement = 1u << 20;
+
+    std::vector<std::vector<uint32_t>> buckets(bucketCount);
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        buckets[GetBucket(entries[i].Hash, bucketCount)].push_back(i);
+    }
+
+    std::vector<uint32_t> order(bucketCount);
+    for (uint32_t i = 0; i < bucketCount; ++i) {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t x, uint32_t y) {
+        return buckets[x].size() > buckets[y].size();
+    });
+
+    displacements.assign(bucketCount, 0);
+    slots.assign(slotCount, PCI_IDS_ENTRY{ 0, PCI_IDS_EMPTY, 0 });
+    std::vector<bool> used(slotCount, false);
+    std::vector<uint32_t> taken;
+
+    for (uint32_t bucket : order) {
+        const auto& members = buckets[bucket];
+        if (members.empty()) {
+            break;
+        }
+
+        bool placed = false;
+        for (uint32_t d = 0; d < maxDisplacement && !placed; ++d) {
+            taken.clear();
+            placed = true;
+            for (uint32_t index : members) {
+                uint32_t slot = GetSlot(entries[index].Hash, d, slotCount);
+                if (used[slot] || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+                    placed = false;
+                    break;
+                }
+                taken.push_back(slot);
+            }
+
+            if (placed) {
+                displacements[bucket] = d;
+                for (size_t i = 0; i < members.size(); ++i) {
+                    const auto& source = entries[members[i]];
+                    used[taken[i]] = true;
+                    slots[taken[i]] = PCI_IDS_ENTRY{ source.Key, source.Kind, source.NameOffset };
+                }
+            }
+        }
+
+        if (!placed) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool PCI_Ids_Database::Compile(const std::string& idsPath, const std::string& outputPath, std::string& err) {
+    std::vector<PCI_IDS_SOURCE_ENTRY> entries;
+    std::string strings;
+    if (!ParseIdsFile(idsPath, entries, strings, err)) {
+        return false;
+    }
+
+    for (auto& entry : entries) {
+        entry.Hash = MixKey(entry.Kind, entry.Key);
+    }
+
+    // ~4       ~90%;    
+    uint32_t count = static_cast<uint32_t>(entries.size());
+    uint32_t bucketCount = std::max<uint32_t>(1, count / 4);
+    uint32_t slotCount = count + count / 9 + 1;
+    std::vector<uint32_t> displacements;
+    std::vector<PCI_IDS_ENTRY> slots;
+
+    bool built = false;
+    for (int attempt = 0; attempt < 8 && !built; ++attempt) {
+        built = BuildPerfectHash(entries, bucketCount, slotCount, displacements, slots);
+        slotCount += slotCount / 8 + 1;
+    }
+    if (!built) {
+        err = "Failed to build perfect hash";
+        return false;
+    }
+
+    PCI_IDS_HEADER header{};
+    header.Magic = Magic;
+    header.Version = Version;
+    header.EntryCount = count;
+    header.SlotCount = static_cast<uint32_t>(slots.size());
+    header.BucketCount = bucketCount;
+    header.StringsSize = static_cast<uint32_t>(strings.size());
+
+    std::ofstream out(outputPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        err = std::format("Cannot create {}", outputPath);
+        return false;
+    }
+
+    size_t padding = GetSlotsOffset(bucketCount) - sizeof(header) - displacements.size() * sizeof(uint32_t);
+    const char zeros[8] = {};
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(displacements.data()), displacements.size() * sizeof(uint32_t));
+    out.write(zeros, padding);
+    out.write(reinterpret_cast<const char*>(slots.data()), slots.size() * sizeof(PCI_IDS_ENTRY));
+    out.write(strings.data(), strings.size());
+
+    if (!out) {
+        err = std::format("Failed to write {}", outputPath);
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
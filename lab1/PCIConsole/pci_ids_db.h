@@ -0,0 +1,61 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include "mapped_file.h"
+
+#pragma pack(push, 1)
+
+struct PCI_IDS_HEADER {
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t Reserved;
+    uint32_t EntryCount;
+    uint32_t SlotCount;
+    uint32_t BucketCount;
+    uint32_t StringsSize;
+};
+
+struct PCI_IDS_ENTRY {
+    uint64_t Key;
+    uint32_t Kind;
+    uint32_t NameOffset;
+};
+
+#pragma pack(pop)
+
+enum PCI_IDS_KIND : uint32_t {
+    PCI_IDS_EMPTY = 0,
+    PCI_IDS_VENDOR = 1,
+    PCI_IDS_DEVICE = 2,
+    PCI_IDS_SUBSYSTEM = 3,
+    PCI_IDS_CLASS = 4
+};
+
+class PCI_Ids_Database {
+private:
+    Mapped_File m_file;
+    const PCI_IDS_HEADER* m_header{ nullptr };
+    const uint32_t* m_displacements{ nullptr };
+    const PCI_IDS_ENTRY* m_slots{ nullptr };
+    const char* m_strings{ nullptr };
+
+public:
+    static constexpr uint32_t Magic = 0x53444950;
+    static constexpr uint16_t Version = 2;
+
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const;
+    uint32_t GetEntryCount() const;
+
+    const char* FindVendor(uint16_t vendor) const;
+    const char* FindDevice(uint16_t vendor, uint16_t device) const;
+    const char* FindSubsystem(uint16_t vendor, uint16_t device, uint16_t subVendor, uint16_t subDevice) const;
+    const char* FindClass(uint8_t baseClass) const;
+    const char* FindSubClass(uint8_t baseClass, uint8_t subClass) const;
+
+    static bool Compile(const std::string& idsPath, const std::string& outputPath, std::string& err);
+
+private:
+    const char* Find(PCI_IDS_KIND kind, uint64_t key) const;
+};
\ No newline at end of file
@@ -0,0 +1,163 @@
+#include "pci_inventory.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <stdexcept>
+#include <format>
+#include "config_space.h"
+#include "../PCICommon/pci_snapshot.h"
+
+//        -     
+bool PCI_Inventory::Open(const std::string& path) {
+    Close();
+
+    if (!m_file.Open(path)) {
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const PCI_INVENTORY_HEADER*>(m_file.Data());
+    if (m_file.Size() < sizeof(PCI_INVENTORY_HEADER) ||
+        header->Magic != PCI_INVENTORY_MAGIC ||
+        header->Version != PCI_INVENTORY_VERSION ||
+        header->RecordSize < sizeof(PCI_INVENTORY_RECORD) ||
+        (m_file.Size() - sizeof(PCI_INVENTORY_HEADER)) / header->RecordSize < header->RecordCount) {
+        m_file.Close();
+        return false;
+    }
+
+    m_header = header;
+    m_records = m_file.Data() + sizeof(PCI_INVENTORY_HEADER);
+
+    for (uint32_t i = 1; i < header->RecordCount; ++i) {
+        if (PCI_INVENTORY_KEY(&GetRecord(i - 1)) >= PCI_INVENTORY_KEY(&GetRecord(i))) {
+            Close();
+            return false;
+        }
+    }
+    return true;
+}
+
+void PCI_Inventory::Close() {
+    m_header = nullptr;
+    m_records = nullptr;
+    m_file.Close();
+}
+
+bool PCI_Inventory::IsOpen() const {
+    return m_header != nullptr;
+}
+
+uint32_t PCI_Inventory::GetCount() const {
+    return m_header ? m_header->RecordCount : 0;
+}
+
+const PCI_INVENTORY_RECORD& PCI_Inventory::GetRecord(uint32_t index) const {
+    return *reinterpret_cast<const PCI_INVENTORY_RECORD*>(m_records + static_cast<size_t>(index) * m_header->RecordSize);
+}
+
+std::string PCI_Inventory::GetHostName() const {
+    if (!m_header) {
+        return {};
+    }
+    return std::string(m_header->HostName, strnlen(m_header->HostName, sizeof(m_header->HostName)));
+}
+
+uint64_t PCI_Inventory::GetTimestamp() const {
+    return m_header ? m_header->Timestamp : 0;
+}
+
+//   ,     
+PCI_INVENTORY_RECORD PCI_Inventory::MakeRecord(const PCI_DEVICE_INFO& device) {
+    PCI_INVENTORY_RECORD record{};
+    record.Segment = device.Segment;
+    record.Bus = device.Bus;
+    record.DevFn = PCI_DEVFN(device.Device, device.Function);
+    record.VendorID = device.VendorID;
+    record.DeviceID = device.DeviceID;
+    record.Revision = device.Revision;
+    record.ProgIF = device.ProgIF;
+    record.SubClass = device.SubClass;
+    record.BaseClass = device.BaseClass;
+    record.SubsystemVendorID = device.SubsystemVendorID;
+    record.SubsystemID = device.SubsystemID;
+    record.HeaderType = device.HeaderType;
+
+    PCI_Config_Space config(device);
+    if (config.IsValid()) {
+        config.GetLinkStatus(record.LinkSpeed, record.LinkWidth);
+    }
+    return record;
+}
+
+//       ,    BDF -  
+//     ,     
+void PCI_Inventory::Save(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Device_Index& index,
+    const std::string& path, const std::string& hostName) {
+    std::vector<PCI_INVENTORY_RECORD> records;
+    records.reserve(index.Size());
+    for (uint32_t position : index.GetKeyOrder()) {
+        records.push_back(MakeRecord(devices[position]));
+    }
+
+    PCI_INVENTORY_HEADER header{};
+    header.Magic = PCI_INVENTORY_MAGIC;
+    header.Version = PCI_INVENTORY_VERSION;
+    header.RecordSize = sizeof(PCI_INVENTORY_RECORD);
+    header.RecordCount = static_cast<uint32_t>(records.size());
+    header.Timestamp = static_cast<uint64_t>(std::time(nullptr));
+    std::memcpy(header.HostName, hostName.data(), std::min(hostName.size(), sizeof(header.HostName) - 1));
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(std::format("Cannot create inventory {}", path));
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(PCI_INVENTORY_RECORD));
+    if (!out) {
+        throw std::runtime_error(std::format("Failed to write inventory {}", path));
+    }
+}
+
+bool PCI_Inventory::IsSameFunction(const PCI_INVENTORY_RECORD& a, const PCI_INVENTORY_RECORD& b) {
+    return a.VendorID == b.VendorID && a.DeviceID == b.DeviceID && a.Revision == b.Revision &&
+        a.ProgIF == b.ProgIF && a.SubClass == b.SubClass && a.BaseClass == b.BaseClass &&
+        a.SubsystemVendorID == b.SubsystemVendorID && a.SubsystemID == b.SubsystemID &&
+        a.HeaderType == b.HeaderType;
+}
+
+//    (0)   
+bool PCI_Inventory::IsLinkDowngraded(const PCI_INVENTORY_RECORD& base, const PCI_INVENTORY_RECORD& other) {
+    if (!base.LinkSpeed || !other.LinkSpeed) {
+        return false;
+    }
+    return other.LinkSpeed < base.LinkSpeed || other.LinkWidth < base.LinkWidth;
+}
+
+//         
+void PCI_Inventory::Compare(const PCI_Inventory& base, const PCI_Inventory& other, std::vector<PCI_INVENTORY_CHANGE>& changes) {
+    changes.clear();
+
+    uint32_t left = 0, right = 0;
+    uint32_t leftCount = base.GetCount(), rightCount = other.GetCount();
+
+    while (left < leftCount || right < rightCount) {
+        if (right == rightCount ||
+            (left < leftCount && PCI_INVENTORY_KEY(&base.GetRecord(left)) < PCI_INVENTORY_KEY(&other.GetRecord(right)))) {
+            changes.push_back({ PCI_CHANGE_KIND::Removed, false, base.GetRecord(left++), {} });
+            continue;
+        }
+
+        const PCI_INVENTORY_RECORD& record = other.GetRecord(right++);
+        if (left == leftCount || PCI_INVENTORY_KEY(&record) < PCI_INVENTORY_KEY(&base.GetRecord(left))) {
+            changes.push_back({ PCI_CHANGE_KIND::Added, false, {}, record });
+            continue;
+        }
+
+        const PCI_INVENTORY_RECORD& previous = base.GetRecord(left++);
+        bool downgraded = IsLinkDowngraded(previous, record);
+        if (downgraded || !IsSameFunction(previous, record)) {
+            changes.push_back({ PCI_CHANGE_KIND::Changed, downgraded, previous, record });
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "mapped_file.h"
+#include "pci_device_info.h"
+#include "pci_device_index.h"
+#include "scan_delta.h"
+#include "../PCICommon/pci_inventory.h"
+
+struct PCI_INVENTORY_CHANGE {
+    PCI_CHANGE_KIND Kind;
+    bool LinkDowngraded;
+    PCI_INVENTORY_RECORD Base;
+    PCI_INVENTORY_RECORD Other;
+};
+
+class PCI_Inventory {
+private:
+    Mapped_File m_file;
+    const PCI_INVENTORY_HEADER* m_header{ nullptr };
+    const uint8_t* m_records{ nullptr };
+
+public:
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const;
+
+    uint32_t GetCount() const;
+    const PCI_INVENTORY_RECORD& GetRecord(uint32_t index) const;
+    std::string GetHostName() const;
+    uint64_t GetTimestamp() const;
+
+    static void Save(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Device_Index& index,
+        const std::string& path, const std::string& hostName);
+    static void Compare(const PCI_Inventory& base, const PCI_Inventory& other, std::vector<PCI_INVENTORY_CHANGE>& changes);
+
+private:
+    static PCI_INVENTORY_RECORD MakeRecord(const PCI_DEVICE_INFO& device);
+    static bool IsSameFunction(const PCI_INVENTORY_RECORD& a, const PCI_INVENTORY_RECORD& b);
+    static bool IsLinkDowngraded(const PCI_INVENTORY_RECORD& base, const PCI_INVENTORY_RECORD& other);
+};
\ No newline at end of file
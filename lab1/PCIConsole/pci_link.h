@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+
+struct PCI_LINK {
+    uint8_t PortType;
+    uint8_t MaxSpeed;
+    uint8_t MaxWidth;
+    uint8_t Speed;
+    uint8_t Width;
+};
+
+struct PCI_LINK_TUNING {
+    uint8_t PortType;
+    uint8_t PayloadSupported;
+    uint8_t Payload;
+    uint8_t ReadRequest;
+    bool RelaxedOrdering;
+    uint8_t AspmSupported;
+    uint8_t AspmEnabled;
+    uint8_t L0sExitLatency;
+    uint8_t L1ExitLatency;
+    uint8_t L0sAcceptable;
+    uint8_t L1Acceptable;
+};
\ No newline at end of file
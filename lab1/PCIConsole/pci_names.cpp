@@ -0,0 +1,111 @@
+#include "pci_names.h"
+
+//     Class/Subclass
+const char* PCI_Name_Resolver::GetDeviceType(uint8_t base_class, uint8_t sub_class) {
+    switch (base_class) {
+    case 0x00: return "Pre-2.0 Device";
+    case 0x01:
+        switch (sub_class) {
+        case 0x00: return "SCSI Controller";
+        case 0x01: return "IDE Controller";
+        case 0x02: return "Floppy Controller";
+        case 0x03: return "IPI Controller";
+        case 0x04: return "RAID Controller";
+        case 0x05: return "ATA Controller";
+        case 0x06: return "SATA Controller";
+        case 0x80: return "Other Mass Storage";
+        default: return "Mass Storage Controller";
+        }
+    case 0x02:
+        switch (sub_class) {
+        case 0x00: return "Ethernet Controller";
+        case 0x01: return "Token Ring Controller";
+        case 0x02: return "FDDI Controller";
+        case 0x03: return "ATM Controller";
+        case 0x04: return "ISDN Controller";
+        case 0x80: return "Other Network Controller";
+        default: return "Network Controller";
+        }
+    case 0x03:
+        switch (sub_class) {
+        case 0x00: return "VGA Compatible Controller";
+        case 0x01: return "XGA Controller";
+        case 0x02: return "3D Controller";
+        case 0x80: return "Other Display Controller";
+        default: return "Display Controller";
+        }
+    case 0x06:
+        switch (sub_class) {
+        case 0x00: return "Host Bridge";
+        case 0x01: return "ISA Bridge";
+        case 0x02: return "EISA Bridge";
+        case 0x03: return "MCA Bridge";
+        case 0x04: return "PCI-to-PCI Bridge";
+        case 0x05: return "PCMCIA Bridge";
+        case 0x06: return "NuBus Bridge";
+        case 0x07: return "CardBus Bridge";
+        case 0x08: return "RACEway Bridge";
+        case 0x80: return "Other Bridge";
+        default: return "Bridge Device";
+        }
+    case 0x0C:
+        switch (sub_class) {
+        case 0x00: return "Serial Controller";
+        case 0x01: return "Parallel Controller";
+        case 0x02: return "Multiport Serial Controller";
+        case 0x03: return "Modem";
+        case 0x80: return "Other Communications";
+        default: return "Communications Controller";
+        }
+    default: return "Unknown Device";
+    }
+}
+
+//    VendorID
+const char* PCI_Name_Resolver::GetVendorName(uint16_t vendor_id) {
+    switch (vendor_id) {
+    case 0x8086: return "Intel";
+    case 0x10DE: return "NVIDIA";
+    case 0x1002: return "AMD";
+    case 0x1414: return "Microsoft";
+    case 0x5333: return "S3";
+    case 0x1011: return "Digital Equipment";
+    case 0x10EC: return "Realtek";
+    case 0x1969: return "Atheros";
+    default: return "Unknown Vendor";
+    }
+}
+
+bool PCI_Name_Resolver::LoadDatabase(const std::string& path) {
+    return m_database.Open(path);
+}
+
+bool PCI_Name_Resolver::HasDatabase() const {
+    return m_database.IsOpen();
+}
+
+//     "<> <> [<>]".
+//          
+std::string PCI_Name_Resolver::Describe(const PCI_DEVICE_INFO& device) const {
+    const char* vendor = m_database.FindVendor(device.VendorID);
+    const char* name = m_database.FindDevice(device.VendorID, device.DeviceID);
+    if (!name) {
+        name = m_database.FindSubClass(device.BaseClass, device.SubClass);
+    }
+    if (!name) {
+        name = m_database.FindClass(device.BaseClass);
+    }
+
+    std::string description = std::format("{} {}",
+        vendor ? vendor : GetVendorName(device.VendorID),
+        name ? name : GetDeviceType(device.BaseClass, device.SubClass));
+
+    if (device.SubsystemVendorID != 0 && device.SubsystemVendorID != 0xFFFF) {
+        const char* subsystem = m_database.FindSubsystem(device.VendorID, device.DeviceID,
+            device.SubsystemVendorID, device.SubsystemID);
+        if (subsystem) {
+            description += std::format(" [{}]", subsystem);
+        }
+    }
+    return description;
+}
\ No newline at end of file
@@ -0,0 +1,17 @@
+#pragma once
+#include <string>
+#include "pci_device_info.h"
+#include "pci_ids_db.h"
+
+class PCI_Name_Resolver {
+private:
+    PCI_Ids_Database m_database;
+
+public:
+    bool LoadDatabase(const std::string& path);
+    bool HasDatabase() const;
+    std::string Describe(const PCI_DEVICE_INFO& device) const;
+
+    static const char* GetVendorName(uint16_t vendor_id);
+    static const char* GetDeviceType(uint8_t base_class, uint8_t sub_class);
+};
\ No newline at end of file
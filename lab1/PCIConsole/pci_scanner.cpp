@@ -1,4 +1,14 @@
 #include "pci_scanner.h"
+#include <algorithm>
+#include "pci_decoder.h"
+
+PCI_Scanner_App::PCI_Scanner_App()
+    : m_backend(PCI_Backend::CreateDefault()) {
+}
+
+PCI_Scanner_App::PCI_Scanner_App(std::unique_ptr<PCI_Backend> backend)
+    : m_backend(std::move(backend)) {
+}
 
 PCI_Scanner_App::~PCI_Scanner_App() {
     Close();
@@ -13,54 +23,256 @@ void PCI_Scanner_App::Shutdown() {
 }
 
 bool PCI_Scanner_App::Open() {
-    m_hDevice = CreateFileW(
-        L"\\\\.\\PCIScanner",
-        GENERIC_READ | GENERIC_WRITE,
-        0,
-        nullptr,
-        OPEN_EXISTING,
-        FILE_ATTRIBUTE_NORMAL,
-        nullptr
-    );
-
-    return (m_hDevice != INVALID_HANDLE_VALUE);
+    Scan_Phase_Timer timer(m_stats, SCAN_PHASE::Open);
+    return m_backend->Open();
 }
 
 void PCI_Scanner_App::Close() {
-    if (m_hDevice && m_hDevice != INVALID_HANDLE_VALUE) {
-        CloseHandle(m_hDevice);
-        m_hDevice = nullptr;
-    }
+    m_backend->Close();
 }
 
+//    -   ,     
 std::vector<PCI_DEVICE_INFO> PCI_Scanner_App::Scan() {
+    return Scan(PCI_FILTER{});
+}
+
+//   -    
+std::vector<PCI_DEVICE_INFO> PCI_Scanner_App::Scan(const PCI_FILTER& filter) {
     std::vector<PCI_DEVICE_INFO> devices;
+    PCI_SCAN_OPTIONS options;
+    options.Filter = filter;
+
+    Scan(options, [&](PCI_DEVICE_INFO& device) {
+        devices.push_back(std::move(device));
+        return true;
+    });
+
+    Rebase(devices);
+    return devices;
+}
+
+//       ,    .
+//       ;    ,  false.
+//     ;       ScanDelta
+PCI_SCAN_STATUS PCI_Scanner_App::Scan(const PCI_SCAN_OPTIONS& options, const PCI_DEVICE_CALLBACK& callback) {
+    if (!IsOpen()) {
+        throw std::runtime_error("Device not opened");
+    }
+
+    m_backend->SetFilter(options.Filter);
 
+    PCI_SCAN_STATUS status = PCI_SCAN_STATUS::Completed;
+    Scan_Phase_Timer timer(m_stats, SCAN_PHASE::Enumerate);
+    m_backend->EnumerateBatches([&](std::vector<PCI_DEVICE_INFO>& batch) {
+        // ,     ,   
+        if (options.Cancel && *options.Cancel) {
+            status = PCI_SCAN_STATUS::Cancelled;
+            return false;
+        }
+        if (std::chrono::steady_clock::now() >= options.Deadline) {
+            status = PCI_SCAN_STATUS::DeadlineExceeded;
+            return false;
+        }
+
+        for (auto& device : batch) {
+            {
+                Scan_Phase_Timer naming(m_stats, SCAN_PHASE::NameLookup);
+                device.Description = m_names.Describe(device);
+            }
+            if (!callback(device)) {
+                status = PCI_SCAN_STATUS::Cancelled;
+                return false;
+            }
+        }
+        return true;
+    });
+
+    return status;
+}
+
+std::unique_ptr<PCI_Scan_Stream> PCI_Scanner_App::ScanAsync(const PCI_SCAN_OPTIONS& options) {
     if (!IsOpen()) {
         throw std::runtime_error("Device not opened");
     }
+    return std::make_unique<PCI_Scan_Stream>(*this, options);
+}
 
-    PCI_DEVICE_LIST deviceList{};
-    DWORD bytesReturned = 0;
-
-    BOOL result = DeviceIoControl(
-        m_hDevice,
-        IOCTL_PCI_GET_DEVICES,
-        nullptr, 0,
-        &deviceList, sizeof(deviceList),
-        &bytesReturned,
-        nullptr
-    );
-
-    if (!result) {
-        DWORD error = GetLastError();
-        throw std::runtime_error(std::format("DeviceIoControl failed with error: {}", error));
+//         BDF .
+//        
+PCI_SCAN_DELTA PCI_Scanner_App::ScanDelta() {
+    if (!IsOpen()) {
+        throw std::runtime_error("Device not opened");
     }
 
-    devices.assign(deviceList.Devices, deviceList.Devices + deviceList.NumberOfDevices);
-    return devices;
+    m_backend->Enumerate(m_current);
+    SortByKey(m_current);
+
+    PCI_SCAN_DELTA delta;
+    size_t prev = 0, curr = 0;
+
+    while (prev < m_previous.size() || curr < m_current.size()) {
+        if (curr == m_current.size() ||
+            (prev < m_previous.size() && m_previous[prev].GetKey() < m_current[curr].GetKey())) {
+            //       
+            PCI_DEVICE_INFO& removed = m_previous[prev++];
+            removed.Config = nullptr;
+            removed.ConfigSize = 0;
+            delta.Changes.push_back({ PCI_CHANGE_KIND::Removed, std::move(removed) });
+            continue;
+        }
+
+        PCI_DEVICE_INFO& device = m_current[curr++];
+
+        if (prev == m_previous.size() || device.GetKey() < m_previous[prev].GetKey()) {
+            device.Description = m_names.Describe(device);
+            delta.Changes.push_back({ PCI_CHANGE_KIND::Added, device });
+            continue;
+        }
+
+        PCI_DEVICE_INFO& previous = m_previous[prev++];
+        if (device.GetFingerprint() != previous.GetFingerprint()) {
+            device.Description = m_names.Describe(device);
+            delta.Changes.push_back({ PCI_CHANGE_KIND::Changed, device });
+        }
+        else {
+            device.Description = std::move(previous.Description);
+        }
+    }
+
+    std::swap(m_previous, m_current);
+    delta.Generation = ++m_generation;
+    return delta;
+}
+
+uint64_t PCI_Scanner_App::GetGeneration() const {
+    return m_generation;
+}
+
+//        -    
+void PCI_Scanner_App::SetConfigCapture(bool enabled) {
+    m_backend->SetConfigCapture(enabled);
+}
+
+//    ; nullptr  
+void PCI_Scanner_App::SetStats(Scan_Stats* stats) {
+    m_stats = stats;
+    m_backend->SetStats(stats);
 }
 
 bool PCI_Scanner_App::IsOpen() const {
-    return m_hDevice && m_hDevice != INVALID_HANDLE_VALUE;
+    return m_backend->IsOpen();
+}
+
+PCI_Backend& PCI_Scanner_App::GetBackend() const {
+    return *m_backend;
+}
+
+//   pci.ids      -    
+bool PCI_Scanner_App::LoadNameDatabase(const std::string& path) {
+    return m_names.LoadDatabase(path);
+}
+
+//  BAR    ,    .
+// BAR       ,  .  - - 
+//  :       64      ,
+//      ,   LookupAddress  
+const PCI_Resource_Map& PCI_Scanner_App::BuildResourceMap(const std::vector<PCI_DEVICE_INFO>& devices) {
+    std::vector<PCI_RESOURCE> resources;
+    std::vector<PCI_RESOURCE> ioPorts;
+    std::vector<PCI_BAR> bars;
+    PCI_BAR_SIZES sizes;
+    size_t unsized = 0;
+
+    for (const auto& device : devices) {
+        if (!device.Config) {
+            continue;
+        }
+
+        m_backend->ReadBarSizes(device, sizes);
+        PCI_Config_Decoder::DecodeBars(device.Config, device.ConfigSize, &sizes, bars);
+
+        for (const auto& bar : bars) {
+            if (bar.Size == 0) {
+                ++unsized;
+                continue;
+            }
+            auto& target = bar.Type == PCI_BAR_TYPE::Io ? ioPorts : resources;
+            target.push_back({ bar.Address, bar.Address + bar.Size - 1, device.Segment, device.Bus, device.Device, device.Function,
+                device.VendorID, device.DeviceID, bar });
+        }
+    }
+
+    m_resources.Build(std::move(resources), unsized);
+    m_ioPorts.Build(std::move(ioPorts), 0);
+    return m_resources;
+}
+
+std::vector<const PCI_RESOURCE*> PCI_Scanner_App::LookupAddress(uint64_t address) const {
+    std::vector<const PCI_RESOURCE*> matches;
+    m_resources.Find(address, matches);
+    return matches;
+}
+
+//     ;    -    ,
+//     ,   
+const PCI_Device_Index& PCI_Scanner_App::BuildIndex(const std::vector<PCI_DEVICE_INFO>& devices) {
+    m_index.Build(devices);
+    return m_index;
+}
+
+//     ,    
+const PCI_Topology& PCI_Scanner_App::BuildTopology(const std::vector<PCI_DEVICE_INFO>& devices) {
+    m_topology.Build(devices);
+    return m_topology;
+}
+
+//    : capability PCIe   
+const PCI_Link_Report& PCI_Scanner_App::AnalyzeLinks(const std::vector<PCI_DEVICE_INFO>& devices) {
+    m_topology.Build(devices);
+    m_links.Build(devices, m_topology);
+    return m_links;
+}
+
+//     ,     
+const PCI_Tuning_Audit& PCI_Scanner_App::AuditTuning(const std::vector<PCI_DEVICE_INFO>& devices) {
+    m_topology.Build(devices);
+    m_audit.Build(devices, m_topology);
+    return m_audit;
+}
+
+//  NUMA    ;      .
+// /proc/interrupts       
+std::vector<PCI_LOCALITY_ENTRY> PCI_Scanner_App::BuildLocalityReport(std::vector<PCI_DEVICE_INFO>& devices,
+    const std::string& interruptsPath) {
+    std::vector<PCI_LOCALITY_ENTRY> entries;
+    std::vector<uint32_t> irqs;
+    std::vector<uint32_t> wanted;
+
+    for (size_t i = 0; i < devices.size(); ++i) {
+        if (!m_backend->ReadLocality(devices[i], irqs) || irqs.empty()) {
+            continue;
+        }
+        wanted.insert(wanted.end(), irqs.begin(), irqs.end());
+        PCI_LOCALITY_ENTRY& entry = entries.emplace_back();
+        entry.Index = static_cast<uint32_t>(i);
+        entry.Irqs = irqs;
+    }
+
+    Proc_Interrupts interrupts;
+    interrupts.Load(interruptsPath, std::move(wanted));
+    Irq_Locality::Build(devices, interrupts, entries);
+    return entries;
+}
+
+//       ScanDelta
+void PCI_Scanner_App::Rebase(const std::vector<PCI_DEVICE_INFO>& devices) {
+    m_previous = devices;
+    SortByKey(m_previous);
+    ++m_generation;
+}
+
+void PCI_Scanner_App::SortByKey(std::vector<PCI_DEVICE_INFO>& devices) {
+    std::sort(devices.begin(), devices.end(), [](const PCI_DEVICE_INFO& a, const PCI_DEVICE_INFO& b) {
+        return a.GetKey() < b.GetKey();
+    });
 }
\ No newline at end of file
@@ -1,15 +1,38 @@
 #pragma once
-#include <windows.h>
+#include <memory>
 #include <vector>
 #include <stdexcept>
 #include "pci_device_info.h"
+#include "pci_backend.h"
+#include "pci_names.h"
+#include "scan_delta.h"
+#include "resource_map.h"
+#include "pci_topology.h"
+#include "pci_device_index.h"
+#include "irq_locality.h"
+#include "link_report.h"
+#include "tuning_audit.h"
+#include "scan_stream.h"
+#include "scan_stats.h"
 
 class PCI_Scanner_App {
 private:
-    HANDLE m_hDevice{ nullptr };
+    std::unique_ptr<PCI_Backend> m_backend;
+    std::vector<PCI_DEVICE_INFO> m_previous;
+    std::vector<PCI_DEVICE_INFO> m_current;
+    PCI_Name_Resolver m_names;
+    PCI_Resource_Map m_resources;
+    PCI_Resource_Map m_ioPorts;
+    PCI_Topology m_topology;
+    PCI_Device_Index m_index;
+    PCI_Link_Report m_links;
+    PCI_Tuning_Audit m_audit;
+    Scan_Stats* m_stats{ nullptr };
+    uint64_t m_generation{ 0 };
 
 public:
-    PCI_Scanner_App() = default;
+    PCI_Scanner_App();
+    explicit PCI_Scanner_App(std::unique_ptr<PCI_Backend> backend);
     ~PCI_Scanner_App();
 
     PCI_Scanner_App(const PCI_Scanner_App&) = delete;
@@ -18,9 +41,30 @@ public:
     bool Initialize();
     void Shutdown();
     std::vector<PCI_DEVICE_INFO> Scan();
+    std::vector<PCI_DEVICE_INFO> Scan(const PCI_FILTER& filter);
+    PCI_SCAN_STATUS Scan(const PCI_SCAN_OPTIONS& options, const PCI_DEVICE_CALLBACK& callback);
+    std::unique_ptr<PCI_Scan_Stream> ScanAsync(const PCI_SCAN_OPTIONS& options);
+    //  ,    Scan; Scan()     
+    PCI_SCAN_DELTA ScanDelta();
+    uint64_t GetGeneration() const;
+    void SetConfigCapture(bool enabled);
+    void SetStats(Scan_Stats* stats);
     bool IsOpen() const;
+    PCI_Backend& GetBackend() const;
+    bool LoadNameDatabase(const std::string& path);
+    const PCI_Resource_Map& BuildResourceMap(const std::vector<PCI_DEVICE_INFO>& devices);
+    std::vector<const PCI_RESOURCE*> LookupAddress(uint64_t address) const;
+    const PCI_Resource_Map& GetIoPortMap() const { return m_ioPorts; }
+    const PCI_Device_Index& BuildIndex(const std::vector<PCI_DEVICE_INFO>& devices);
+    const PCI_Topology& BuildTopology(const std::vector<PCI_DEVICE_INFO>& devices);
+    const PCI_Link_Report& AnalyzeLinks(const std::vector<PCI_DEVICE_INFO>& devices);
+    const PCI_Tuning_Audit& AuditTuning(const std::vector<PCI_DEVICE_INFO>& devices);
+    std::vector<PCI_LOCALITY_ENTRY> BuildLocalityReport(std::vector<PCI_DEVICE_INFO>& devices,
+        const std::string& interruptsPath = Proc_Interrupts::DefaultPath);
 
 private:
     bool Open();
     void Close();
+    void Rebase(const std::vector<PCI_DEVICE_INFO>& devices);
+    static void SortByKey(std::vector<PCI_DEVICE_INFO>& devices);
 };
\ No newline at end of file
@@ -0,0 +1,84 @@
+#include "pci_topology.h"
+#include <algorithm>
+#include <array>
+#include <numeric>
+#include "../PCICommon/pci_config.h"
+
+//  i  devices[i].     -     ,
+//     " -> ",       BDF:
+//       ,   ,    .
+//       -     
+void PCI_Topology::Build(const std::vector<PCI_DEVICE_INFO>& devices) {
+    m_nodes.assign(devices.size(), { None, None, None, 0 });
+    m_roots.clear();
+
+    std::vector<uint32_t> order(devices.size());
+    std::iota(order.begin(), order.end(), 0u);
+    auto byKey = [&](uint32_t a, uint32_t b) { return devices[a].GetKey() < devices[b].GetKey(); };
+    if (!std::is_sorted(order.begin(), order.end(), byKey)) {
+        std::sort(order.begin(), order.end(), byKey);
+    }
+
+    std::array<uint32_t, PCI_MAX_BUSES> busOwner;
+    busOwner.fill(None);
+    std::vector<uint32_t> lastChild(devices.size(), None);
+    uint32_t segment = None;
+
+    for (uint32_t index : order) {
+        const PCI_DEVICE_INFO& device = devices[index];
+        PCI_TOPOLOGY_NODE& node = m_nodes[index];
+        if (device.Segment != segment) {
+            segment = device.Segment;
+            busOwner.fill(None);
+        }
+        node.Parent = busOwner[device.Bus];
+
+        //      -      BDF
+        if (node.Parent == None) {
+            m_roots.push_back(index);
+        }
+        else {
+            node.Depth = m_nodes[node.Parent].Depth + 1;
+            uint32_t& tail = lastChild[node.Parent];
+            if (tail == None) {
+                m_nodes[node.Parent].FirstChild = index;
+            }
+            else {
+                m_nodes[tail].NextSibling = index;
+            }
+            tail = index;
+        }
+
+        //          
+        if (device.SecondaryBus > device.Bus && device.SubordinateBus >= device.SecondaryBus &&
+            busOwner[device.SecondaryBus] == None) {
+            busOwner[device.SecondaryBus] = index;
+        }
+    }
+}
+
+//        
+std::vector<uint32_t> PCI_Topology::GetPathToRoot(uint32_t index) const {
+    std::vector<uint32_t> path;
+    if (index >= m_nodes.size()) {
+        return path;
+    }
+
+    path.reserve(m_nodes[index].Depth);
+    for (uint32_t parent = m_nodes[index].Parent; parent != None; parent = m_nodes[parent].Parent) {
+        path.push_back(parent);
+    }
+    return path;
+}
+
+//   -    ,    
+uint32_t PCI_Topology::GetRootPort(uint32_t index) const {
+    if (index >= m_nodes.size() || m_nodes[index].Parent == None) {
+        return None;
+    }
+
+    while (m_nodes[index].Parent != None) {
+        index = m_nodes[index].Parent;
+    }
+    return index;
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pci_device_info.h"
+
+struct PCI_TOPOLOGY_NODE {
+    uint32_t Parent;
+    uint32_t FirstChild;
+    uint32_t NextSibling;
+    uint16_t Depth;
+};
+
+class PCI_Topology {
+private:
+    std::vector<PCI_TOPOLOGY_NODE> m_nodes;
+    std::vector<uint32_t> m_roots;
+
+public:
+    static constexpr uint32_t None = UINT32_MAX;
+
+    void Build(const std::vector<PCI_DEVICE_INFO>& devices);
+
+    size_t Size() const { return m_nodes.size(); }
+    const PCI_TOPOLOGY_NODE& GetNode(uint32_t index) const { return m_nodes[index]; }
+    const std::vector<uint32_t>& GetRoots() const { return m_roots; }
+    std::vector<uint32_t> GetPathToRoot(uint32_t index) const;
+    uint32_t GetRootPort(uint32_t index) const;
+};
\ No newline at end of file
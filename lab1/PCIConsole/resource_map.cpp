@@ -0,0 +1,61 @@
+#include "resource_map.h"
+#include <algorithm>
+
+//        :   [low, high)
+//            
+void PCI_Resource_Map::Build(std::vector<PCI_RESOURCE> resources, size_t unsized) {
+    m_resources = std::move(resources);
+    m_unsized = unsized;
+
+    std::sort(m_resources.begin(), m_resources.end(), [](const PCI_RESOURCE& a, const PCI_RESOURCE& b) {
+        return a.Start < b.Start;
+    });
+
+    m_maxEnd.assign(m_resources.size(), 0);
+    BuildNode(0, m_resources.size());
+}
+
+void PCI_Resource_Map::Clear() {
+    m_resources.clear();
+    m_maxEnd.clear();
+    m_unsized = 0;
+}
+
+uint64_t PCI_Resource_Map::BuildNode(size_t low, size_t high) {
+    if (low >= high) {
+        return 0;
+    }
+
+    size_t middle = low + (high - low) / 2;
+    uint64_t maxEnd = std::max({ m_resources[middle].End, BuildNode(low, middle), BuildNode(middle + 1, high) });
+    m_maxEnd[middle] = maxEnd;
+    return maxEnd;
+}
+
+//   BAR      - O(log n)
+void PCI_Resource_Map::Find(uint64_t address, std::vector<const PCI_RESOURCE*>& matches) const {
+    matches.clear();
+    FindNode(0, m_resources.size(), address, matches);
+}
+
+void PCI_Resource_Map::FindNode(size_t low, size_t high, uint64_t address, std::vector<const PCI_RESOURCE*>& matches) const {
+    if (low >= high) {
+        return;
+    }
+
+    size_t middle = low + (high - low) / 2;
+    if (m_maxEnd[middle] < address) {
+        return;
+    }
+
+    FindNode(low, middle, address, matches);
+
+    //      
+    const PCI_RESOURCE& resource = m_resources[middle];
+    if (resource.Start <= address) {
+        if (address <= resource.End) {
+            matches.push_back(&resource);
+        }
+        FindNode(middle + 1, high, address, matches);
+    }
+}
\ No newline at end of file
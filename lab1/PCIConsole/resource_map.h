@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pci_bar.h"
+
+struct PCI_RESOURCE {
+    uint64_t Start;
+    uint64_t End;
+    uint16_t Segment;
+    uint8_t Bus;
+    uint8_t Device;
+    uint8_t Function;
+    uint16_t VendorID;
+    uint16_t DeviceID;
+    PCI_BAR Bar;
+};
+
+class PCI_Resource_Map {
+private:
+    std::vector<PCI_RESOURCE> m_resources;
+    std::vector<uint64_t> m_maxEnd;
+    size_t m_unsized{ 0 };
+
+public:
+    void Build(std::vector<PCI_RESOURCE> resources, size_t unsized);
+    void Clear();
+
+    size_t Size() const { return m_resources.size(); }
+    size_t GetUnsizedCount() const { return m_unsized; }
+    const std::vector<PCI_RESOURCE>& GetResources() const { return m_resources; }
+    void Find(uint64_t address, std::vector<const PCI_RESOURCE*>& matches) const;
+
+private:
+    uint64_t BuildNode(size_t low, size_t high);
+    void FindNode(size_t low, size_t high, uint64_t address, std::vector<const PCI_RESOURCE*>& matches) const;
+};
\ No newline at end of file
@@ -0,0 +1,218 @@
+#include "ring_backend.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+#include "pci_decoder.h"
+
+void Ring_Backend::Enumerate(std::vector<PCI_DEVICE_INFO>& devices) {
+    devices.clear();
+    EnumerateBatches([&](std::vector<PCI_DEVICE_INFO>& batch) {
+        devices.insert(devices.end(), std::make_move_iterator(batch.begin()), std::make_move_iterator(batch.end()));
+        return true;
+    });
+}
+
+//        ,    
+//  ,       .    .
+//        
+bool Ring_Backend::EnumerateBatches(const PCI_BATCH_CALLBACK& onBatch) {
+    if (!IsOpen()) {
+        throw std::runtime_error("Ring backend not opened");
+    }
+
+    uint16_t configSize = std::min<uint16_t>(m_captureConfig ? PCI_CFG_SPACE_SIZE : PCI_CFG_HEADER_SIZE, m_ring.ConfigSize);
+    std::vector<PCI_DEVICE_INFO> batch;
+    bool completed = true;
+    uint32_t state = PCI_RING_RUNNING;
+
+    m_config.clear();
+    PciRingReset(&m_ring);
+    StartProducer(configSize);
+
+    try {
+        const PCI_WIRE_RECORD* record = nullptr;
+        while ((state = WaitForRecord(record)) == PCI_RING_RUNNING) {
+            PCI_DEVICE_INFO device;
+            const uint8_t* config = PciRingRecordConfig(&m_ring, record);
+            {
+                Scan_Phase_Timer decode(m_stats, SCAN_PHASE::Decode);
+                PCI_Config_Decoder::DecodeWireRecord(*record, device);
+                PCI_Config_Decoder::DecodeHeader(config, configSize, device);
+            }
+            if (m_captureConfig) {
+                auto& copy = m_config.emplace_back();
+                std::memcpy(copy.data(), config, configSize);
+                device.Config = copy.data();
+                device.ConfigSize = configSize;
+            }
+            PciRingRelease(&m_ring);
+
+            if (!Matches(device)) {
+                continue;
+            }
+            if (!batch.empty() && (batch.back().Segment != device.Segment || batch.back().Bus != device.Bus)) {
+                if (!onBatch(batch)) {
+                    completed = false;
+                    break;
+                }
+                batch.clear();
+            }
+            batch.push_back(std::move(device));
+        }
+    }
+    catch (...) {
+        PciRingCancel(&m_ring);
+        StopProducer();
+        throw;
+    }
+
+    if (!completed) {
+        PciRingCancel(&m_ring);
+    }
+    StopProducer();
+
+    if (completed && state == PCI_RING_STALLED) {
+        throw std::runtime_error("Ring producer stalled: records were not consumed in time");
+    }
+    if (completed && !batch.empty()) {
+        completed = onBatch(batch);
+    }
+    return completed;
+}
+
+//   ,    ,   .
+// ,   DONE ( ),   
+uint32_t Ring_Backend::WaitForRecord(const PCI_WIRE_RECORD*& record) {
+    while ((record = PciRingPeek(&m_ring)) == nullptr) {
+        bool producing = m_producing.load(std::memory_order_acquire);
+        uint32_t state = PciRingPoll(&m_ring);
+        if (state != PCI_RING_RUNNING) {
+            return state;
+        }
+        if (!producing && !PciRingPeek(&m_ring)) {
+            return PCI_RING_DONE;
+        }
+        std::this_thread::yield();
+    }
+    return PCI_RING_RUNNING;
+}
+
+void Ring_Backend::StartProducer(uint16_t configSize) {
+    m_error = nullptr;
+    m_producing.store(true, std::memory_order_release);
+    m_producer = std::thread([this, configSize] {
+        try {
+            Produce(configSize);
+        }
+        catch (...) {
+            m_error = std::current_exception();
+        }
+        m_producing.store(false, std::memory_order_release);
+    });
+}
+
+void Ring_Backend::StopProducer() {
+    if (m_producer.joinable()) {
+        m_producer.join();
+    }
+    if (m_error) {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+}
+
+//   user space  :        
+//   .   ,     
+Synthetic_Ring_Backend::Synthetic_Ring_Backend(const SYNTHETIC_TOPOLOGY_PARAMS& params)
+    : m_topology(params) {
+}
+
+bool Synthetic_Ring_Backend::Open() {
+    m_memory.assign(PciRingSize(DefaultCapacity, PCI_CFG_SPACE_SIZE), 0);
+    if (!PciRingInit(&m_producerRing, m_memory.data(), static_cast<uint32_t>(m_memory.size()), DefaultCapacity, PCI_CFG_SPACE_SIZE) ||
+        !PciRingAttach(&m_ring, m_memory.data(), static_cast<uint32_t>(m_memory.size()))) {
+        m_memory.clear();
+        return false;
+    }
+    return true;
+}
+
+void Synthetic_Ring_Backend::Close() {
+    m_memory.clear();
+    m_memory.shrink_to_fit();
+}
+
+bool Synthetic_Ring_Backend::ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config) {
+    uint16_t size = 0;
+    const uint8_t* data = m_topology.GetConfig(device.Bus, device.Device, device.Function, size);
+    if (!data) {
+        config.clear();
+        return false;
+    }
+    config.assign(data, data + size);
+    return true;
+}
+
+void Synthetic_Ring_Backend::Produce(uint16_t configSize) {
+    PCI_WALK_OPS ops{};
+    PCI_WALK_STATS stats{};
+
+    m_scanConfigSize = configSize;
+    PciRingBegin(&m_producerRing);
+
+    ops.ReadConfig = &ReadTopology;
+    ops.Visit = &PublishFunction;
+    ops.Context = this;
+    ops.Filter = &m_filter;
+    ops.ConfigSize = PCI_CFG_EXT_SPACE_SIZE;
+
+    PciWalkTopology(&ops, &stats);
+    PciRingFinish(&m_producerRing, PCI_RING_DONE);
+}
+
+//      -     .
+//   ,  Vendor ID   0xFFFF
+uint32_t Synthetic_Ring_Backend::ReadTopology(void* context, uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
+    auto* backend = static_cast<Synthetic_Ring_Backend*>(context);
+    if (!backend->m_stats) {
+        return backend->m_topology.Read(bus, device, function, offset);
+    }
+
+    uint64_t start = Scan_Stats::Now();
+    uint32_t value = backend->m_topology.Read(bus, device, function, offset);
+    backend->m_stats->RecordRead(0, bus, Scan_Stats::Now() - start,
+        offset == PCI_CFG_ID && PCI_ID_VENDOR(value) == PCI_INVALID_VENDOR_ID);
+    return value;
+}
+
+//    ;      
+int Synthetic_Ring_Backend::PublishFunction(void* context, const PCI_WALK_FUNCTION* function) {
+    auto* backend = static_cast<Synthetic_Ring_Backend*>(context);
+    PCI_RING* ring = &backend->m_producerRing;
+
+    PCI_WIRE_RECORD* record;
+    while ((record = PciRingReserve(ring)) == nullptr) {
+        if (PciRingIsCancelled(ring)) {
+            return 0;
+        }
+        std::this_thread::yield();
+    }
+    if (PciRingIsCancelled(ring)) {
+        return 0;
+    }
+
+    PciWireFillRecord(record, function);
+
+    uint8_t* config = PciRingRecordConfig(ring, record);
+    uint16_t size = 0;
+    const uint8_t* source = backend->m_topology.GetConfig(function->Bus, function->Device, function->Function, size);
+    size = source ? std::min(size, backend->m_scanConfigSize) : 0;
+    if (size) {
+        std::memcpy(config, source, size);
+    }
+    std::memset(config + size, 0xFF, backend->m_scanConfigSize - size);
+
+    PciRingCommit(ring);
+    return 1;
+}
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <thread>
+#include <vector>
+#include "pci_backend.h"
+#include "synthetic_topology.h"
+#include "../PCICommon/pci_config.h"
+#include "../PCICommon/pci_ring.h"
+
+class Ring_Backend : public PCI_Backend {
+protected:
+    static constexpr uint32_t DefaultCapacity = 1024;
+
+    PCI_RING m_ring{};
+    std::deque<std::array<uint8_t, PCI_CFG_SPACE_SIZE>> m_config;
+
+private:
+    std::thread m_producer;
+    std::atomic<bool> m_producing{ false };
+    std::exception_ptr m_error;
+
+public:
+    void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) override;
+    bool EnumerateBatches(const PCI_BATCH_CALLBACK& onBatch) override;
+
+protected:
+    virtual void Produce(uint16_t configSize) = 0;
+
+private:
+    void StartProducer(uint16_t configSize);
+    void StopProducer();
+    uint32_t WaitForRecord(const PCI_WIRE_RECORD*& record);
+};
+
+class Synthetic_Ring_Backend : public Ring_Backend {
+private:
+    Synthetic_Topology m_topology;
+    std::vector<uint8_t> m_memory;
+    PCI_RING m_producerRing{};
+    uint16_t m_scanConfigSize{ 0 };
+
+public:
+    explicit Synthetic_Ring_Backend(const SYNTHETIC_TOPOLOGY_PARAMS& params);
+
+    bool Open() override;
+    void Close() override;
+    bool IsOpen() const override { return !m_memory.empty(); }
+    bool ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config) override;
+    const char* GetName() const override { return "ring"; }
+
+protected:
+    void Produce(uint16_t configSize) override;
+
+private:
+    static uint32_t ReadTopology(void* context, uint8_t bus, uint8_t device, uint8_t function, uint16_t offset);
+    static int PublishFunction(void* context, const PCI_WALK_FUNCTION* function);
+};
\ No newline at end of file
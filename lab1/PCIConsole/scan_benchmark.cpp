@@ -0,0 +1,176 @@
+#include "scan_benchmark.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <stdexcept>
+#include <format>
+#include "../PCICommon/pci_config.h"
+#include "../PCICommon/pci_walk.h"
+#include "../PCICommon/pci_wire.h"
+#ifndef _WIN32
+#include <sys/stat.h>
+#include "sysfs_backend.h"
+#endif
+
+struct TOPOLOGY_WALK_CONTEXT {
+    const Synthetic_Topology* Topology;
+    std::vector<uint8_t> Buffer;
+};
+
+static uint32_t ReadTopology(void* context, uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
+    return static_cast<TOPOLOGY_WALK_CONTEXT*>(context)->Topology->Read(bus, device, function, offset);
+}
+
+//   ,   :       
+static int StoreWalkFunction(void* context, const PCI_WALK_FUNCTION* function) {
+    auto* walk = static_cast<TOPOLOGY_WALK_CONTEXT*>(context);
+
+    PCI_WIRE_RECORD record{};
+    PciWireFillRecord(&record, function);
+
+    PciWireAppend(walk->Buffer.data(), static_cast<uint32_t>(walk->Buffer.size()), &record);
+    return 1;
+}
+
+//     ( ScanPciDevices)    256x32x8.
+//     -   
+std::vector<TOPOLOGY_BENCH_RESULT> Scan_Benchmark::RunTopology(const Synthetic_Topology& topology, unsigned iterations) {
+    std::vector<TOPOLOGY_BENCH_RESULT> results;
+    iterations = std::max(iterations, 1u);
+
+    TOPOLOGY_WALK_CONTEXT context{ &topology, {} };
+    context.Buffer.resize(PciWireBufferSize(topology.GetStats().Functions, 0));
+
+    PCI_WALK_OPS ops{};
+    ops.ReadConfig = &ReadTopology;
+    ops.Visit = &StoreWalkFunction;
+    ops.Context = &context;
+    ops.ConfigSize = PCI_CFG_EXT_SPACE_SIZE;
+
+    PCI_WALK_STATS stats{};
+    uint64_t probes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i) {
+        PciWireBegin(context.Buffer.data(), 0);
+        PciWalkTopology(&ops, &stats);
+        probes += stats.ConfigReads;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    results.push_back({ "topology walk", probes / iterations, stats.FunctionsFound,
+        elapsed.count() * 1000 / iterations, elapsed.count() > 0 ? probes / elapsed.count() : 0 });
+
+    probes = 0;
+    uint32_t found = 0;
+    start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < iterations; ++i) {
+        found = 0;
+        for (uint32_t bdf = 0; bdf < PCI_MAX_BUSES * PCI_MAX_DEVICES * PCI_MAX_FUNCTIONS; ++bdf) {
+            uint32_t id = topology.Read(static_cast<uint8_t>(bdf >> 8), static_cast<uint8_t>((bdf >> 3) & 0x1F),
+                static_cast<uint8_t>(bdf & 7), PCI_CFG_ID);
+            found += PCI_ID_VENDOR(id) != PCI_INVALID_VENDOR_ID;
+            ++probes;
+        }
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    results.push_back({ "exhaustive probe", probes / iterations, found,
+        elapsed.count() * 1000 / iterations, elapsed.count() > 0 ? probes / elapsed.count() : 0 });
+
+    return results;
+}
+
+//     /sys/bus/pci/devices:   8 ,  32   
+void Scan_Benchmark::GenerateSysfsTree(const std::string& root, size_t functions) {
+#ifdef _WIN32
+    throw std::runtime_error("sysfs benchmark is only available on Linux");
+#else
+    if (functions > PCI_MAX_BUSES * PCI_MAX_DEVICES * PCI_MAX_FUNCTIONS) {
+        throw std::runtime_error("Too many functions for segment 0");
+    }
+
+    mkdir(root.c_str(), 0755);
+
+    for (size_t i = 0; i < functions; ++i) {
+        unsigned bus = static_cast<unsigned>(i / (PCI_MAX_DEVICES * PCI_MAX_FUNCTIONS));
+        unsigned device = static_cast<unsigned>(i / PCI_MAX_FUNCTIONS % PCI_MAX_DEVICES);
+        unsigned function = static_cast<unsigned>(i % PCI_MAX_FUNCTIONS);
+
+        std::string dir = std::format("{}/0000:{:02x}:{:02x}.{:x}", root, bus, device, function);
+        mkdir(dir.c_str(), 0755);
+
+        uint8_t config[PCI_CFG_SPACE_SIZE] = {};
+        uint16_t deviceId = static_cast<uint16_t>(0x1000 + function);
+        config[0] = 0x86;
+        config[1] = 0x80;
+        config[2] = static_cast<uint8_t>(deviceId);
+        config[3] = static_cast<uint8_t>(deviceId >> 8);
+        config[0x0B] = 0x02;
+        config[0x0E] = function == 0 ? PCI_HEADER_MULTIFUNCTION : PCI_HEADER_TYPE_NORMAL;
+
+        std::string path = dir + "/config";
+        FILE* file = std::fopen(path.c_str(), "wb");
+        if (!file) {
+            throw std::runtime_error(std::format("Cannot create {}", path));
+        }
+        std::fwrite(config, 1, sizeof(config), file);
+        std::fclose(file);
+    }
+#endif
+}
+
+//      1, 2, 4 ... maxThreads ;    
+std::vector<SCAN_BENCH_RESULT> Scan_Benchmark::RunSysfs(const std::string& root, unsigned iterations, unsigned maxThreads) {
+    std::vector<SCAN_BENCH_RESULT> results;
+#ifdef _WIN32
+    throw std::runtime_error("sysfs benchmark is only available on Linux");
+#else
+    std::vector<unsigned> threadCounts;
+    for (unsigned threads = 1; threads < maxThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(std::max(maxThreads, 1u));
+
+    std::vector<PCI_DEVICE_INFO> devices;
+    double baseline = 0;
+
+    for (unsigned threads : threadCounts) {
+        Sysfs_Backend backend(root, threads);
+        if (!backend.Open()) {
+            throw std::runtime_error(std::format("Cannot open {}", root));
+        }
+        backend.Enumerate(devices);
+
+        auto start = std::chrono::steady_clock::now();
+        for (unsigned i = 0; i < iterations; ++i) {
+            backend.Enumerate(devices);
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        double perScan = elapsed.count() / iterations;
+        if (threads == 1) {
+            baseline = perScan;
+        }
+        results.push_back({ threads, devices.size(), perScan, perScan > 0 ? baseline / perScan : 0 });
+    }
+#endif
+    return results;
+}
+
+//    :           .
+//    -      AER
+AER_BENCH_RESULT Scan_Benchmark::RunAer(Aer_Sampler& sampler, unsigned ticks) {
+    AER_BENCH_RESULT result{};
+    result.Ticks = std::max(ticks, 1u);
+    sampler.Sample();
+
+    size_t sampled = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (unsigned i = 0; i < result.Ticks; ++i) {
+        sampled += sampler.Sample();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+    result.Devices = sampled / result.Ticks;
+    result.MicrosecondsPerTick = elapsed.count() / result.Ticks;
+    result.MicrosecondsPerDevice = sampled ? elapsed.count() / sampled : 0.0;
+    return result;
+}
\ No newline at end of file
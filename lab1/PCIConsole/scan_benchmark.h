@@ -0,0 +1,38 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "synthetic_topology.h"
+#include "aer_sampler.h"
+
+struct SCAN_BENCH_RESULT {
+    unsigned Threads;
+    size_t Functions;
+    double MillisecondsPerScan;
+    double Speedup;
+};
+
+struct TOPOLOGY_BENCH_RESULT {
+    const char* Method;
+    uint64_t Probes;
+    uint32_t FunctionsFound;
+    double MillisecondsPerScan;
+    double ReadsPerSecond;
+};
+
+struct AER_BENCH_RESULT {
+    size_t Devices;
+    unsigned Ticks;
+    double MicrosecondsPerTick;
+    double MicrosecondsPerDevice;
+};
+
+class Scan_Benchmark {
+public:
+    static std::vector<TOPOLOGY_BENCH_RESULT> RunTopology(const Synthetic_Topology& topology, unsigned iterations);
+
+    static void GenerateSysfsTree(const std::string& root, size_t functions);
+    static std::vector<SCAN_BENCH_RESULT> RunSysfs(const std::string& root, unsigned iterations, unsigned maxThreads);
+    static AER_BENCH_RESULT RunAer(Aer_Sampler& sampler, unsigned ticks);
+};
\ No newline at end of file
@@ -0,0 +1,24 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "pci_device_info.h"
+
+enum class PCI_CHANGE_KIND {
+    Added,
+    Removed,
+    Changed
+};
+
+struct PCI_DEVICE_CHANGE {
+    PCI_CHANGE_KIND Kind;
+    PCI_DEVICE_INFO Device;
+};
+
+struct PCI_SCAN_DELTA {
+    uint64_t Generation{ 0 };
+    std::vector<PCI_DEVICE_CHANGE> Changes;
+
+    bool IsEmpty() const {
+        return Changes.empty();
+    }
+};
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "scan_stats.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+
+// -    HDR Histogram:   16  , 
+//      16  -     1/16
+unsigned Latency_Histogram::GetIndex(uint64_t value) {
+    if (value < SubBucketCount) {
+        return static_cast<unsigned>(value);
+    }
+    unsigned shift = static_cast<unsigned>(std::bit_width(value)) - 1 - SubBucketBits;
+    return (shift + 1) * SubBucketCount + static_cast<unsigned>((value >> shift) - SubBucketCount);
+}
+
+//  ,   
+uint64_t Latency_Histogram::GetUpperBound(unsigned index) {
+    if (index < SubBucketCount) {
+        return index;
+    }
+    unsigned shift = index / SubBucketCount - 1;
+    uint64_t lower = static_cast<uint64_t>(SubBucketCount + index % SubBucketCount) << shift;
+    return lower + ((1ull << shift) - 1);
+}
+
+void Latency_Histogram::Record(uint64_t value) {
+    ++m_counts[GetIndex(value)];
+    ++m_count;
+    m_sum += value;
+    m_max = std::max(m_max, value);
+}
+
+void Latency_Histogram::Merge(const Latency_Histogram& other) {
+    for (unsigned i = 0; i < BucketCount; ++i) {
+        m_counts[i] += other.m_counts[i];
+    }
+    m_count += other.m_count;
+    m_sum += other.m_sum;
+    m_max = std::max(m_max, other.m_max);
+}
+
+double Latency_Histogram::GetMean() const {
+    return m_count ? static_cast<double>(m_sum) / static_cast<double>(m_count) : 0.0;
+}
+
+//   ,      
+uint64_t Latency_Histogram::GetPercentile(double percentile) const {
+    if (!m_count) {
+        return 0;
+    }
+
+    uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * static_cast<double>(m_count))));
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < BucketCount; ++i) {
+        seen += m_counts[i];
+        if (seen >= target) {
+            return std::min(GetUpperBound(i), m_max);
+        }
+    }
+    return m_max;
+}
+
+//    :         
+static std::atomic<uint64_t> g_nextStatsId{ 1 };
+
+Scan_Stats::Scan_Stats()
+    : m_id(g_nextStatsId.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+uint64_t Scan_Stats::Now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+//        ;    ,
+//       
+SCAN_THREAD_STATS& Scan_Stats::Local() {
+    thread_local uint64_t owner = 0;
+    thread_local SCAN_THREAD_STATS* local = nullptr;
+
+    if (owner != m_id) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_threads.push_back(std::make_unique<SCAN_THREAD_STATS>());
+        local = m_threads.back().get();
+        owner = m_id;
+    }
+    return *local;
+}
+
+//      ,     
+//         
+void Scan_Stats::RecordRead(uint16_t segment, uint8_t bus, uint64_t latencyNs, bool absent) {
+    SCAN_THREAD_STATS& local = Local();
+    uint32_t key = (static_cast<uint32_t>(segment) << 8) | bus;
+    if (key != local.LastBus) {
+        local.LastBus = key;
+        local.LastProbes = &local.Buses[key];
+    }
+
+    local.Reads.Record(latencyNs);
+    ++local.LastProbes->Reads;
+    if (absent) {
+        ++local.AbsentReads;
+        ++local.LastProbes->Absent;
+    }
+}
+
+void Scan_Stats::AddPhase(SCAN_PHASE phase, uint64_t elapsedNs) {
+    Local().PhaseNs[static_cast<size_t>(phase)] += elapsedNs;
+}
+
+//    :     
+//    ,        
+SCAN_STATS_SUMMARY Scan_Stats::Collect() const {
+    SCAN_STATS_SUMMARY summary;
+    std::unordered_map<uint32_t, SCAN_BUS_PROBES> buses;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& local : m_threads) {
+        summary.Reads.Merge(local->Reads);
+        summary.AbsentReads += local->AbsentReads;
+        for (size_t i = 0; i < summary.PhaseNs.size(); ++i) {
+            summary.PhaseNs[i] += local->PhaseNs[i];
+        }
+        for (const auto& [key, probes] : local->Buses) {
+            buses[key].Reads += probes.Reads;
+            buses[key].Absent += probes.Absent;
+        }
+        summary.Threads += local->Reads.GetCount() != 0;
+    }
+
+    summary.Buses.assign(buses.begin(), buses.end());
+    std::sort(summary.Buses.begin(), summary.Buses.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    return summary;
+}
+
+//        
+Scan_Phase_Timer::Scan_Phase_Timer(Scan_Stats* stats, SCAN_PHASE phase)
+    : m_stats(stats), m_phase(phase), m_start(stats ? Scan_Stats::Now() : 0) {
+}
+
+Scan_Phase_Timer::~Scan_Phase_Timer() {
+    if (m_stats) {
+        m_stats->AddPhase(m_phase, Scan_Stats::Now() - m_start);
+    }
+}
\ No newline at end of file
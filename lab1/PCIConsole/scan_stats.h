@@ -0,0 +1,101 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+enum class SCAN_PHASE {
+    Open,
+    Enumerate,
+    Decode,
+    NameLookup,
+    Format,
+    Count
+};
+
+struct SCAN_BUS_PROBES {
+    uint64_t Reads{ 0 };
+    uint64_t Absent{ 0 };
+};
+
+class Latency_Histogram {
+public:
+    static constexpr unsigned SubBucketBits = 4;
+    static constexpr unsigned SubBucketCount = 1u << SubBucketBits;
+    static constexpr unsigned BucketCount = (64 - SubBucketBits + 1) * SubBucketCount;
+
+private:
+    std::array<uint64_t, BucketCount> m_counts{};
+    uint64_t m_count{ 0 };
+    uint64_t m_sum{ 0 };
+    uint64_t m_max{ 0 };
+
+public:
+    void Record(uint64_t value);
+    void Merge(const Latency_Histogram& other);
+    uint64_t GetCount() const { return m_count; }
+    uint64_t GetMax() const { return m_max; }
+    uint64_t GetBucket(unsigned index) const { return m_counts[index]; }
+    double GetMean() const;
+    uint64_t GetPercentile(double percentile) const;
+
+    static unsigned GetIndex(uint64_t value);
+    static uint64_t GetUpperBound(unsigned index);
+};
+
+struct SCAN_THREAD_STATS {
+    Latency_Histogram Reads;
+    uint64_t AbsentReads{ 0 };
+    std::array<uint64_t, static_cast<size_t>(SCAN_PHASE::Count)> PhaseNs{};
+    std::unordered_map<uint32_t, SCAN_BUS_PROBES> Buses;
+    uint32_t LastBus{ UINT32_MAX };
+    SCAN_BUS_PROBES* LastProbes{ nullptr };
+};
+
+struct SCAN_STATS_SUMMARY {
+    Latency_Histogram Reads;
+    uint64_t AbsentReads{ 0 };
+    unsigned Threads{ 0 };
+    std::array<uint64_t, static_cast<size_t>(SCAN_PHASE::Count)> PhaseNs{};
+    std::vector<std::pair<uint32_t, SCAN_BUS_PROBES>> Buses;
+};
+
+class Scan_Stats {
+private:
+    uint64_t m_id;
+    mutable std::mutex m_mutex;
+    std::vector<std::unique_ptr<SCAN_THREAD_STATS>> m_threads;
+
+public:
+    Scan_Stats();
+
+    Scan_Stats(const Scan_Stats&) = delete;
+    Scan_Stats& operator=(const Scan_Stats&) = delete;
+
+    void RecordRead(uint16_t segment, uint8_t bus, uint64_t latencyNs, bool absent);
+    void AddPhase(SCAN_PHASE phase, uint64_t elapsedNs);
+    SCAN_STATS_SUMMARY Collect() const;
+
+    static uint64_t Now();
+
+private:
+    SCAN_THREAD_STATS& Local();
+};
+
+class Scan_Phase_Timer {
+private:
+    Scan_Stats* m_stats;
+    SCAN_PHASE m_phase;
+    uint64_t m_start;
+
+public:
+    Scan_Phase_Timer(Scan_Stats* stats, SCAN_PHASE phase);
+    ~Scan_Phase_Timer();
+
+    Scan_Phase_Timer(const Scan_Phase_Timer&) = delete;
+    Scan_Phase_Timer& operator=(const Scan_Phase_Timer&) = delete;
+};
\ No newline at end of file
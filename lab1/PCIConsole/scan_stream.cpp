@@ -0,0 +1,96 @@
+#include "scan_stream.h"
+#include <utility>
+#include "pci_scanner.h"
+
+//     ,    Next  
+//  .   ,     
+PCI_Scan_Stream::PCI_Scan_Stream(PCI_Scanner_App& scanner, const PCI_SCAN_OPTIONS& options)
+    : m_scanner(scanner),
+    m_options(options) {
+    m_thread = std::thread(&PCI_Scan_Stream::Produce, this);
+}
+
+PCI_Scan_Stream::~PCI_Scan_Stream() {
+    Cancel();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+}
+
+//    ; false -  ,   GetStatus.
+//    :       
+bool PCI_Scan_Stream::Next(PCI_DEVICE_INFO& device) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    auto available = [&] { return !m_queue.empty() || m_finished; };
+    bool ready = true;
+    if (m_options.Deadline == std::chrono::steady_clock::time_point::max()) {
+        m_ready.wait(lock, available);
+    }
+    else {
+        ready = m_ready.wait_until(lock, m_options.Deadline, available);
+    }
+
+    if (!ready) {
+        m_status = PCI_SCAN_STATUS::DeadlineExceeded;
+        m_cancel = true;
+        return false;
+    }
+
+    //       
+    if (m_cancel && m_status == PCI_SCAN_STATUS::Completed) {
+        m_status = PCI_SCAN_STATUS::Cancelled;
+    }
+    if (m_status != PCI_SCAN_STATUS::Completed) {
+        return false;
+    }
+    if (!m_queue.empty()) {
+        device = std::move(m_queue.front());
+        m_queue.pop_front();
+        return true;
+    }
+    if (m_error) {
+        std::rethrow_exception(std::exchange(m_error, nullptr));
+    }
+    return false;
+}
+
+void PCI_Scan_Stream::Cancel() {
+    m_cancel = true;
+}
+
+PCI_SCAN_STATUS PCI_Scan_Stream::GetStatus() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_status;
+}
+
+//       
+void PCI_Scan_Stream::Produce() {
+    const std::atomic<bool>* external = m_options.Cancel;
+    PCI_SCAN_OPTIONS options = m_options;
+    options.Cancel = &m_cancel;
+
+    PCI_SCAN_STATUS status = PCI_SCAN_STATUS::Cancelled;
+    std::exception_ptr error;
+    try {
+        status = m_scanner.Scan(options, [&](PCI_DEVICE_INFO& device) {
+            if (external && *external) {
+                return false;
+            }
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queue.push_back(std::move(device));
+            m_ready.notify_one();
+            return true;
+        });
+    }
+    catch (...) {
+        error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_status == PCI_SCAN_STATUS::Completed) {
+        m_status = status;
+    }
+    m_error = error;
+    m_finished = true;
+    m_ready.notify_all();
+}
\ No newline at end of file
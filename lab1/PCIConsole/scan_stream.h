@@ -0,0 +1,55 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include "pci_device_info.h"
+#include "../PCICommon/pci_filter.h"
+
+class PCI_Scanner_App;
+
+enum class PCI_SCAN_STATUS {
+    Completed,
+    Cancelled,
+    DeadlineExceeded
+};
+
+struct PCI_SCAN_OPTIONS {
+    PCI_FILTER Filter{};
+    std::chrono::steady_clock::time_point Deadline = std::chrono::steady_clock::time_point::max();
+    const std::atomic<bool>* Cancel{ nullptr };
+};
+
+using PCI_DEVICE_CALLBACK = std::function<bool(PCI_DEVICE_INFO& device)>;
+
+class PCI_Scan_Stream {
+private:
+    PCI_Scanner_App& m_scanner;
+    PCI_SCAN_OPTIONS m_options;
+    std::atomic<bool> m_cancel{ false };
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    std::deque<PCI_DEVICE_INFO> m_queue;
+    bool m_finished{ false };
+    PCI_SCAN_STATUS m_status{ PCI_SCAN_STATUS::Completed };
+    std::exception_ptr m_error;
+    std::thread m_thread;
+
+public:
+    PCI_Scan_Stream(PCI_Scanner_App& scanner, const PCI_SCAN_OPTIONS& options);
+    ~PCI_Scan_Stream();
+
+    PCI_Scan_Stream(const PCI_Scan_Stream&) = delete;
+    PCI_Scan_Stream& operator=(const PCI_Scan_Stream&) = delete;
+
+    bool Next(PCI_DEVICE_INFO& device);
+    void Cancel();
+    PCI_SCAN_STATUS GetStatus();
+
+private:
+    void Produce();
+};
\ No newline at end of file
@@ -0,0 +1,225 @@
+#include "snapshot_backend.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <format>
+#include "pci_decoder.h"
+#include "config_space.h"
+#include "../PCICommon/pci_config.h"
+
+Snapshot_Backend::Snapshot_Backend(std::string path)
+    : m_path(std::move(path)) {
+}
+
+//          ;   
+//    ,   config  BAR     
+bool Snapshot_Backend::Open() {
+    if (!m_file.Open(m_path)) {
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const PCI_SNAPSHOT_HEADER*>(m_file.Data());
+    if (m_file.Size() < sizeof(PCI_SNAPSHOT_HEADER) ||
+        header->Magic != PCI_SNAPSHOT_MAGIC ||
+        header->Version != PCI_SNAPSHOT_VERSION ||
+        header->EntrySize < sizeof(PCI_SNAPSHOT_ENTRY) ||
+        (m_file.Size() - sizeof(PCI_SNAPSHOT_HEADER)) / header->EntrySize < header->EntryCount) {
+        m_file.Close();
+        return false;
+    }
+    m_header = header;
+
+    m_entries.clear();
+    m_entries.reserve(header->EntryCount);
+    for (uint32_t i = 0; i < header->EntryCount; ++i) {
+        const PCI_SNAPSHOT_ENTRY* entry = GetEntry(i);
+        if (entry->ConfigOffset > m_file.Size() || entry->ConfigSize > m_file.Size() - entry->ConfigOffset) {
+            Close();
+            return false;
+        }
+        m_entries.emplace(GetEntryKey(entry->Segment, entry->Bus, entry->DevFn), i);
+    }
+
+    IndexVirtualFunctions();
+    return true;
+}
+
+// VF    ,  Vendor ID  0xFFFF.  Routing ID 
+//    capability SR-IOV     .
+//   -   RID: VF     PF
+void Snapshot_Backend::IndexVirtualFunctions() {
+    m_virtualFunctions.clear();
+
+    for (uint32_t i = 0; i < m_header->EntryCount; ++i) {
+        const PCI_SNAPSHOT_ENTRY* entry = GetEntry(i);
+        if (entry->ConfigSize <= PCI_CFG_SPACE_SIZE) {
+            continue;
+        }
+
+        const uint8_t* data = m_file.Data() + entry->ConfigOffset;
+        PCI_Config_Space config(data, static_cast<uint16_t>(std::min<uint32_t>(entry->ConfigSize, PCI_CFG_EXT_SPACE_SIZE)));
+        PCI_SRIOV sriov;
+        if (PCI_ID_VENDOR(config.Read32(PCI_CFG_ID)) == PCI_INVALID_VENDOR_ID || !config.GetSriov(sriov)) {
+            continue;
+        }
+
+        uint16_t pfRid = static_cast<uint16_t>((entry->Bus << 8) | entry->DevFn);
+        uint32_t id = PCI_ID_VENDOR(config.Read32(PCI_CFG_ID)) | (static_cast<uint32_t>(sriov.VfDeviceID) << 16);
+        for (uint16_t vf = 0; vf < sriov.NumVFs; ++vf) {
+            uint32_t rid = PciSriovVfRid(pfRid, &sriov, vf);
+            if (rid == PCI_SRIOV_NO_RID) {
+                break;
+            }
+            m_virtualFunctions[(static_cast<uint32_t>(entry->Segment) << 16) | rid] = { id, pfRid };
+        }
+    }
+}
+
+void Snapshot_Backend::Close() {
+    m_header = nullptr;
+    m_virtualFunctions.clear();
+    m_entries.clear();
+    m_file.Close();
+}
+
+bool Snapshot_Backend::IsOpen() const {
+    return m_header != nullptr;
+}
+
+//      ,  
+void Snapshot_Backend::Enumerate(std::vector<PCI_DEVICE_INFO>& devices) {
+    if (!IsOpen()) {
+        throw std::runtime_error("Snapshot not opened");
+    }
+
+    devices.clear();
+    devices.reserve(m_header->EntryCount);
+
+    //    -      
+    Scan_Phase_Timer decode(m_stats, SCAN_PHASE::Decode);
+    for (uint32_t i = 0; i < m_header->EntryCount; ++i) {
+        const PCI_SNAPSHOT_ENTRY* entry = GetEntry(i);
+        PCI_DEVICE_INFO info{};
+        info.Segment = entry->Segment;
+        info.Bus = entry->Bus;
+        info.Device = PCI_DEVFN_DEVICE(entry->DevFn);
+        info.Function = PCI_DEVFN_FUNCTION(entry->DevFn);
+
+        const uint8_t* config = m_file.Data() + entry->ConfigOffset;
+        bool decoded = PCI_Config_Decoder::DecodeHeader(config, entry->ConfigSize, info);
+        if (!decoded) {
+            auto vf = m_virtualFunctions.find(info.GetKey());
+            decoded = vf != m_virtualFunctions.end() &&
+                PCI_Config_Decoder::DecodeVirtualFunction(config, entry->ConfigSize, vf->second.IdDword, vf->second.PhysicalFunction, info);
+        }
+        if (decoded && Matches(info)) {
+            if (m_captureConfig) {
+                info.Config = config;
+                info.ConfigSize = static_cast<uint16_t>(std::min<uint32_t>(entry->ConfigSize, PCI_CFG_EXT_SPACE_SIZE));
+            }
+            devices.push_back(std::move(info));
+        }
+    }
+}
+
+bool Snapshot_Backend::ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config) {
+    const PCI_SNAPSHOT_ENTRY* entry = FindEntry(device);
+    if (!entry) {
+        config.clear();
+        return false;
+    }
+
+    const uint8_t* data = m_file.Data() + entry->ConfigOffset;
+    config.assign(data, data + entry->ConfigSize);
+    return true;
+}
+
+//  BAR    ;        
+bool Snapshot_Backend::ReadBarSizes(const PCI_DEVICE_INFO& device, PCI_BAR_SIZES& sizes) {
+    sizes.fill(0);
+
+    const PCI_SNAPSHOT_ENTRY* entry = FindEntry(device);
+    if (!entry || m_header->EntrySize < sizeof(RECORDED_ENTRY)) {
+        return false;
+    }
+
+    const auto* resources = reinterpret_cast<const PCI_SNAPSHOT_RESOURCES*>(entry + 1);
+    for (size_t i = 0; i < sizes.size(); ++i) {
+        sizes[i] = resources->BarSize[i];
+    }
+    return true;
+}
+
+// : ,  ,    
+void Snapshot_Backend::Record(PCI_Backend& source, const std::string& path) {
+    std::vector<PCI_DEVICE_INFO> devices;
+    source.Enumerate(devices);
+
+    std::vector<RECORDED_ENTRY> entries;
+    std::vector<uint8_t> blob;
+    std::vector<uint8_t> config;
+    PCI_BAR_SIZES sizes;
+    entries.reserve(devices.size());
+
+    for (const auto& device : devices) {
+        if (!source.ReadConfigSpace(device, config)) {
+            continue;
+        }
+
+        RECORDED_ENTRY recorded{};
+        recorded.Entry.Segment = device.Segment;
+        recorded.Entry.Bus = device.Bus;
+        recorded.Entry.DevFn = PCI_DEVFN(device.Device, device.Function);
+        recorded.Entry.ConfigSize = static_cast<uint32_t>(config.size());
+        recorded.Entry.ConfigOffset = static_cast<uint32_t>(blob.size());
+        source.ReadBarSizes(device, sizes);
+        for (size_t i = 0; i < sizes.size(); ++i) {
+            recorded.Resources.BarSize[i] = sizes[i];
+        }
+        entries.push_back(recorded);
+
+        blob.insert(blob.end(), config.begin(), config.end());
+    }
+
+    //      ,    
+    uint32_t dataOffset = static_cast<uint32_t>(sizeof(PCI_SNAPSHOT_HEADER) + entries.size() * sizeof(RECORDED_ENTRY));
+    for (auto& recorded : entries) {
+        recorded.Entry.ConfigOffset += dataOffset;
+    }
+
+    PCI_SNAPSHOT_HEADER header{};
+    header.Magic = PCI_SNAPSHOT_MAGIC;
+    header.Version = PCI_SNAPSHOT_VERSION;
+    header.EntrySize = sizeof(RECORDED_ENTRY);
+    header.EntryCount = static_cast<uint32_t>(entries.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error(std::format("Cannot create snapshot {}", path));
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(RECORDED_ENTRY));
+    out.write(reinterpret_cast<const char*>(blob.data()), blob.size());
+    if (!out) {
+        throw std::runtime_error(std::format("Failed to write snapshot {}", path));
+    }
+}
+
+const PCI_SNAPSHOT_ENTRY* Snapshot_Backend::GetEntry(uint32_t index) const {
+    const uint8_t* table = m_file.Data() + sizeof(PCI_SNAPSHOT_HEADER);
+    return reinterpret_cast<const PCI_SNAPSHOT_ENTRY*>(table + static_cast<size_t>(index) * m_header->EntrySize);
+}
+
+//   ,   PCI_DEVICE_INFO::GetKey;        
+uint32_t Snapshot_Backend::GetEntryKey(uint16_t segment, uint8_t bus, uint8_t devFn) {
+    return (static_cast<uint32_t>(segment) << 16) | (static_cast<uint32_t>(bus) << 8) | devFn;
+}
+
+const PCI_SNAPSHOT_ENTRY* Snapshot_Backend::FindEntry(const PCI_DEVICE_INFO& device) const {
+    if (!IsOpen()) {
+        return nullptr;
+    }
+
+    auto found = m_entries.find(GetEntryKey(device.Segment, device.Bus, PCI_DEVFN(device.Device, device.Function)));
+    return found != m_entries.end() ? GetEntry(found->second) : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "pci_backend.h"
+#include "mapped_file.h"
+#include "../PCICommon/pci_snapshot.h"
+
+class Snapshot_Backend : public PCI_Backend {
+private:
+    std::string m_path;
+    Mapped_File m_file;
+    const PCI_SNAPSHOT_HEADER* m_header{ nullptr };
+
+    struct VIRTUAL_FUNCTION {
+        uint32_t IdDword;
+        uint16_t PhysicalFunction;
+    };
+    std::unordered_map<uint32_t, VIRTUAL_FUNCTION> m_virtualFunctions;
+    std::unordered_map<uint32_t, uint32_t> m_entries;
+
+public:
+    explicit Snapshot_Backend(std::string path);
+
+    bool Open() override;
+    void Close() override;
+    bool IsOpen() const override;
+    void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) override;
+    bool ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config) override;
+    bool ReadBarSizes(const PCI_DEVICE_INFO& device, PCI_BAR_SIZES& sizes) override;
+    const char* GetName() const override { return "snapshot"; }
+
+    static void Record(PCI_Backend& source, const std::string& path);
+
+private:
+    static uint32_t GetEntryKey(uint16_t segment, uint8_t bus, uint8_t devFn);
+
+    struct RECORDED_ENTRY {
+        PCI_SNAPSHOT_ENTRY Entry;
+        PCI_SNAPSHOT_RESOURCES Resources;
+    };
+
+    const PCI_SNAPSHOT_ENTRY* GetEntry(uint32_t index) const;
+    void IndexVirtualFunctions();
+    const PCI_SNAPSHOT_ENTRY* FindEntry(const PCI_DEVICE_INFO& device) const;
+};
\ No newline at end of file
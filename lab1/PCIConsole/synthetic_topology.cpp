@@ -0,0 +1,268 @@
+#include "synthetic_topology.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include "../PCICommon/pci_config.h"
+
+//  0 - ;  Depth    FanOut    
+Synthetic_Topology::Synthetic_Topology(const SYNTHETIC_TOPOLOGY_PARAMS& params)
+    : m_index(PCI_MAX_BUSES * PCI_MAX_DEVICES * PCI_MAX_FUNCTIONS, NoFunction),
+    m_random(params.Seed ? params.Seed : 1),
+    m_latencyNs(params.LatencyNs) {
+    BuildBus(params, 0, 0);
+}
+
+//    : sleep      
+uint32_t Synthetic_Topology::Read(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) const {
+    if (m_latencyNs) {
+        auto until = std::chrono::steady_clock::now() + std::chrono::nanoseconds(m_latencyNs);
+        while (std::chrono::steady_clock::now() < until) {
+        }
+    }
+
+    uint32_t index = m_index[(static_cast<uint32_t>(bus) << 8) | (device << 3) | function];
+    if (index == NoFunction || offset + 4u > m_slots[index].Size) {
+        return 0xFFFFFFFF;
+    }
+
+    uint32_t value;
+    std::memcpy(&value, m_space.data() + m_slots[index].Offset + (offset & ~3u), sizeof(value));
+    return value;
+}
+
+const uint8_t* Synthetic_Topology::GetConfig(uint8_t bus, uint8_t device, uint8_t function, uint16_t& size) const {
+    uint32_t index = m_index[(static_cast<uint32_t>(bus) << 8) | (device << 3) | function];
+    if (index == NoFunction) {
+        size = 0;
+        return nullptr;
+    }
+
+    size = static_cast<uint16_t>(m_slots[index].Size);
+    return m_space.data() + m_slots[index].Offset;
+}
+
+//  0 -  :     .  
+//  -   .    -  -   ,
+//    :       .
+//     VF   :    VF 
+//  ,     
+void Synthetic_Topology::BuildBus(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint8_t bus, unsigned level) {
+    m_stats.Buses++;
+
+    //  SR-IOV  0x80-0xFF    VF
+    bool root = level == 0;
+    unsigned slotLimit = root && params.VirtualFunctions ? PCI_MAX_DEVICES / 2 : PCI_MAX_DEVICES;
+    unsigned switches = std::min(level < params.Depth ? params.FanOut : 0u, slotLimit);
+    unsigned endpoints = std::min(params.Endpoints, slotLimit - switches);
+
+    if (root) {
+        uint32_t vfCursor = (static_cast<uint32_t>(bus) << 8) | 0x80;
+        for (unsigned e = 0; e < endpoints; ++e) {
+            vfCursor = AddDevice(params, (static_cast<uint32_t>(bus) << 8) | ((switches + e) << 3), 0x83, vfCursor);
+        }
+        m_lastBus = std::max(m_lastBus, (vfCursor - 1) >> 8);
+        endpoints = 0;
+    }
+
+    uint8_t portType = root ? PCI_EXP_TYPE_ROOT_PORT : PCI_EXP_TYPE_DOWNSTREAM;
+    for (unsigned p = 0; p < switches + endpoints; ++p) {
+        bool toSwitch = p < switches;
+        if (m_lastBus + (toSwitch ? 2u : 1u) > PCI_MAX_BUSES - 1) {
+            break;
+        }
+
+        uint8_t secondary = static_cast<uint8_t>(++m_lastBus);
+        uint32_t rid = (static_cast<uint32_t>(bus) << 8) | (p << 3);
+        uint16_t linkStatus = TrainLink(params, toSwitch ? 0x84 : 0x83);
+        uint32_t port = AddPort(rid, portType, linkStatus);
+        m_stats.Buses++;
+
+        if (toSwitch) {
+            uint8_t internal = static_cast<uint8_t>(++m_lastBus);
+            uint32_t upstream = AddPort(static_cast<uint32_t>(secondary) << 8, PCI_EXP_TYPE_UPSTREAM, linkStatus);
+            BuildBus(params, internal, level + 1);
+            SetBusNumbers(upstream, secondary, internal);
+        }
+        else {
+            uint32_t vfCursor = AddDevice(params, static_cast<uint32_t>(secondary) << 8, linkStatus, (static_cast<uint32_t>(secondary) << 8) | 0x80);
+            m_lastBus = std::max(m_lastBus, (vfCursor - 1) >> 8);
+        }
+        SetBusNumbers(port, bus, secondary);
+    }
+}
+
+//      ;   -  x2  x8,
+//       .        
+uint16_t Synthetic_Topology::TrainLink(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint16_t linkStatus) {
+    if (params.DegradedPercent && NextRandom() % 100 < params.DegradedPercent) {
+        return static_cast<uint16_t>((linkStatus & 0xF) | 0x20);
+    }
+    return linkStatus;
+}
+
+//        x8 Gen4.    ,
+//      
+uint32_t Synthetic_Topology::AddPort(uint32_t rid, uint8_t portType, uint16_t linkStatus) {
+    uint8_t* config = AddFunction(rid, PCI_CFG_SPACE_SIZE);
+    Write16(config, 0x00, 0x8086);
+    Write16(config, 0x02, portType == PCI_EXP_TYPE_UPSTREAM ? 0x3C01 : 0x3C00);
+    Write16(config, PCI_CFG_STATUS, PCI_STATUS_CAP_LIST);
+    Write32(config, PCI_CFG_CLASS_REV, 0x06040000);
+    config[PCI_CFG_HEADER + 2] = PCI_HEADER_TYPE_BRIDGE;
+    config[PCI_CFG_CAP_PTR] = 0x40;
+    Write16(config, 0x40, PCI_CAP_ID_EXP);
+    Write16(config, 0x40 + PCI_EXP_FLAGS, static_cast<uint16_t>(0x0002 | (portType << 4)));
+    Write32(config, 0x40 + PCI_EXP_DEVCAP, 0x0001);
+    Write16(config, 0x40 + PCI_EXP_DEVCTL, 0x2030);
+    Write32(config, 0x40 + PCI_EXP_LNKCAP, 0x24C84);
+    Write16(config, 0x40 + PCI_EXP_LNKSTA, linkStatus);
+    m_stats.Bridges++;
+    m_stats.Functions++;
+    return m_index[rid];
+}
+
+//      ,      
+void Synthetic_Topology::SetBusNumbers(uint32_t index, uint8_t primary, uint8_t secondary) {
+    uint8_t* config = m_space.data() + m_slots[index].Offset;
+    Write32(config, PCI_CFG_BUS_NUMBERS, primary | (secondary << 8) | (m_lastBus << 16));
+}
+
+//    rid,    ;     
+uint32_t Synthetic_Topology::AddDevice(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint32_t rid, uint16_t linkStatus, uint32_t vfCursor) {
+    bool multifunction = NextRandom() % 100 < params.MultifunctionPercent;
+    unsigned functions = std::clamp(params.FunctionsPerDevice, 1u, static_cast<unsigned>(PCI_MAX_FUNCTIONS));
+
+    for (unsigned f = 0; f < (multifunction ? functions : 1); ++f) {
+        vfCursor = AddEndpoint(params, rid | f, multifunction && f == 0, linkStatus, vfCursor);
+    }
+    return vfCursor;
+}
+
+uint8_t* Synthetic_Topology::AddFunction(uint32_t rid, uint32_t size) {
+    m_index[rid] = static_cast<uint32_t>(m_slots.size());
+    m_slots.push_back({ static_cast<uint32_t>(m_space.size()), size });
+    m_space.resize(m_space.size() + size);
+    return m_space.data() + m_slots.back().Offset;
+}
+
+//   PCIe x8 Gen3  MPS 256  MRRS 512    linkStatus;    VF -    SR-IOV,
+//  VF     vfCursor   1
+uint32_t Synthetic_Topology::AddEndpoint(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint32_t rid, bool multifunction, uint16_t linkStatus, uint32_t vfCursor) {
+    uint32_t vfCount = std::min<uint32_t>(params.VirtualFunctions, 0x10000 - vfCursor);
+    uint8_t* config = AddFunction(rid, vfCount ? PCI_CFG_EXT_SPACE_SIZE : PCI_CFG_SPACE_SIZE);
+
+    Write16(config, 0x00, 0x8086);
+    Write16(config, 0x02, static_cast<uint16_t>(0x1500 + (rid & 7)));
+    Write16(config, PCI_CFG_STATUS, PCI_STATUS_CAP_LIST);
+    Write32(config, PCI_CFG_CLASS_REV, 0x02000001);
+    config[PCI_CFG_HEADER + 2] = multifunction ? PCI_HEADER_MULTIFUNCTION : PCI_HEADER_TYPE_NORMAL;
+    Write32(config, PCI_CFG_SUBSYSTEM, 0x00018086);
+    config[PCI_CFG_CAP_PTR] = 0x40;
+    Write16(config, 0x40, PCI_CAP_ID_EXP);
+    Write16(config, 0x40 + PCI_EXP_FLAGS, 0x0002);
+    Write32(config, 0x40 + PCI_EXP_DEVCAP, 0x0782);
+    Write16(config, 0x40 + PCI_EXP_DEVCTL, 0x2030);
+    Write32(config, 0x40 + PCI_EXP_LNKCAP, 0x14C83);
+    Write16(config, 0x40 + PCI_EXP_LNKSTA, linkStatus);
+    m_stats.Functions++;
+
+    //   : MPS ,   , MRRS 128, ASPM L1,  Relaxed Ordering
+    if (params.MisconfiguredPercent && NextRandom() % 100 < params.MisconfiguredPercent) {
+        switch (NextRandom() % 4) {
+        case 0: Write16(config, 0x40 + PCI_EXP_DEVCTL, 0x2010); break;
+        case 1: Write16(config, 0x40 + PCI_EXP_DEVCTL, 0x0030); break;
+        case 2: Write16(config, 0x40 + PCI_EXP_LNKCTL, PCI_EXP_ASPM_L1); break;
+        default: Write16(config, 0x40 + PCI_EXP_DEVCTL, 0x2020); break;
+        }
+    }
+
+    if (!vfCount) {
+        return vfCursor;
+    }
+
+    uint8_t* sriov = config + PCI_CFG_EXT_CAP_START;
+    Write32(sriov, 0, PCI_EXT_CAP_ID_SRIOV | (1u << 16));
+    Write16(sriov, PCI_SRIOV_CTRL, PCI_SRIOV_CTRL_VFE);
+    Write16(sriov, PCI_SRIOV_INITIAL_VF, static_cast<uint16_t>(vfCount));
+    Write16(sriov, PCI_SRIOV_TOTAL_VF, static_cast<uint16_t>(vfCount));
+    Write16(sriov, PCI_SRIOV_NUM_VF, static_cast<uint16_t>(vfCount));
+    Write16(sriov, PCI_SRIOV_VF_OFFSET, static_cast<uint16_t>(vfCursor - rid));
+    Write16(sriov, PCI_SRIOV_VF_STRIDE, 1);
+    Write16(sriov, PCI_SRIOV_VF_DID, 0x1515);
+    m_stats.PhysicalFunctions++;
+
+    //  VF Vendor ID  Device ID   0xFFFF -     
+    for (uint32_t i = 0; i < vfCount; ++i) {
+        uint8_t* vf = AddFunction(vfCursor + i, PCI_CFG_SPACE_SIZE);
+        Write32(vf, PCI_CFG_ID, 0xFFFFFFFF);
+        Write32(vf, PCI_CFG_CLASS_REV, 0x02000001);
+        Write32(vf, PCI_CFG_SUBSYSTEM, 0x00018086);
+        m_stats.VirtualFunctions++;
+    }
+    return vfCursor + vfCount;
+}
+
+uint32_t Synthetic_Topology::NextRandom() {
+    m_random ^= m_random << 13;
+    m_random ^= m_random >> 17;
+    m_random ^= m_random << 5;
+    return m_random;
+}
+
+void Synthetic_Topology::Write16(uint8_t* config, uint16_t offset, uint16_t value) {
+    std::memcpy(config + offset, &value, sizeof(value));
+}
+
+void Synthetic_Topology::Write32(uint8_t* config, uint16_t offset, uint32_t value) {
+    std::memcpy(config + offset, &value, sizeof(value));
+}
+
+// : "depth=3,fanout=4,endpoints=2,mf=50,functions=8,vfs=16,degraded=10,misconfig=10,latency=500,iterations=10,seed=1"
+bool Synthetic_Topology::ParseParams(const std::string& spec, SYNTHETIC_TOPOLOGY_PARAMS& params, std::string& err) {
+    size_t start = 0;
+    while (start < spec.size()) {
+        size_t end = spec.find(',', start);
+        if (end == std::string::npos) {
+            end = spec.size();
+        }
+
+        std::string item = spec.substr(start, end - start);
+        start = end + 1;
+
+        size_t equals = item.find('=');
+        char* tail = nullptr;
+        unsigned long value = equals == std::string::npos ? 0 : std::strtoul(item.c_str() + equals + 1, &tail, 10);
+        if (equals == std::string::npos || equals + 1 == item.size() || *tail != '\0') {
+            err = "Invalid topology parameter: " + item;
+            return false;
+        }
+
+        std::string key = item.substr(0, equals);
+        unsigned number = static_cast<unsigned>(std::min<unsigned long>(value, 0xFFFFFFFF));
+        if (key == "depth") params.Depth = number;
+        else if (key == "fanout") params.FanOut = number;
+        else if (key == "endpoints") params.Endpoints = number;
+        else if (key == "mf") params.MultifunctionPercent = number;
+        else if (key == "functions") params.FunctionsPerDevice = number;
+        else if (key == "vfs") params.VirtualFunctions = number;
+        else if (key == "degraded") params.DegradedPercent = number;
+        else if (key == "misconfig") params.MisconfiguredPercent = number;
+        else if (key == "latency") params.LatencyNs = number;
+        else if (key == "iterations") params.Iterations = number;
+        else if (key == "seed") params.Seed = number;
+        else {
+            err = "Unknown topology parameter: " + key;
+            return false;
+        }
+    }
+
+    if (params.MultifunctionPercent > 100 || params.DegradedPercent > 100 ||
+        params.MisconfiguredPercent > 100 || params.FunctionsPerDevice == 0 ||
+        params.FunctionsPerDevice > PCI_MAX_FUNCTIONS || params.Iterations == 0) {
+        err = "Topology parameters out of range (mf 0-100, degraded 0-100, misconfig 0-100, functions 1-8, iterations >= 1)";
+        return false;
+    }
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct SYNTHETIC_TOPOLOGY_PARAMS {
+    unsigned Depth{ 2 };
+    unsigned FanOut{ 4 };
+    unsigned Endpoints{ 4 };
+    unsigned MultifunctionPercent{ 25 };
+    unsigned FunctionsPerDevice{ 4 };
+    unsigned VirtualFunctions{ 0 };
+    unsigned DegradedPercent{ 0 };
+    unsigned MisconfiguredPercent{ 0 };
+    unsigned LatencyNs{ 0 };
+    unsigned Iterations{ 10 };
+    uint32_t Seed{ 1 };
+};
+
+struct SYNTHETIC_TOPOLOGY_STATS {
+    uint32_t Buses{ 0 };
+    uint32_t Bridges{ 0 };
+    uint32_t Functions{ 0 };
+    uint32_t PhysicalFunctions{ 0 };
+    uint32_t VirtualFunctions{ 0 };
+};
+
+class Synthetic_Topology {
+private:
+    struct FUNCTION_SLOT {
+        uint32_t Offset;
+        uint32_t Size;
+    };
+
+    static constexpr uint32_t NoFunction = 0xFFFFFFFF;
+
+    std::vector<uint32_t> m_index;
+    std::vector<FUNCTION_SLOT> m_slots;
+    std::vector<uint8_t> m_space;
+    SYNTHETIC_TOPOLOGY_STATS m_stats;
+    uint32_t m_lastBus{ 0 };
+    uint32_t m_random{ 1 };
+    unsigned m_latencyNs{ 0 };
+
+public:
+    explicit Synthetic_Topology(const SYNTHETIC_TOPOLOGY_PARAMS& params);
+
+    uint32_t Read(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) const;
+    const uint8_t* GetConfig(uint8_t bus, uint8_t device, uint8_t function, uint16_t& size) const;
+    const SYNTHETIC_TOPOLOGY_STATS& GetStats() const { return m_stats; }
+    void SetLatency(unsigned nanoseconds) { m_latencyNs = nanoseconds; }
+
+    static bool ParseParams(const std::string& spec, SYNTHETIC_TOPOLOGY_PARAMS& params, std::string& err);
+
+private:
+    void BuildBus(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint8_t bus, unsigned level);
+    uint16_t TrainLink(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint16_t linkStatus);
+    uint32_t AddPort(uint32_t rid, uint8_t portType, uint16_t linkStatus);
+    void SetBusNumbers(uint32_t index, uint8_t primary, uint8_t secondary);
+    uint8_t* AddFunction(uint32_t rid, uint32_t size);
+    uint32_t AddDevice(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint32_t rid, uint16_t linkStatus, uint32_t vfCursor);
+    uint32_t AddEndpoint(const SYNTHETIC_TOPOLOGY_PARAMS& params, uint32_t rid, bool multifunction, uint16_t linkStatus, uint32_t vfCursor);
+    uint32_t NextRandom();
+    static void Write16(uint8_t* config, uint16_t offset, uint16_t value);
+    static void Write32(uint8_t* config, uint16_t offset, uint32_t value);
+};
\ No newline at end of file
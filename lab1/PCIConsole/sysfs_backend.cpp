@@ -0,0 +1,386 @@
+#include "sysfs_backend.h"
+#ifndef _WIN32
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <format>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "pci_decoder.h"
+#include "../PCICommon/pci_config.h"
+
+Sysfs_Backend::Sysfs_Backend(std::string root, unsigned threadCount)
+    : m_root(std::move(root)),
+    m_threadCount(threadCount ? threadCount : Worker_Pool::GetDefaultThreadCount()) {
+}
+
+Sysfs_Backend::~Sysfs_Backend() {
+    Close();
+}
+
+//   :    config  
+bool Sysfs_Backend::Open() {
+    if (!m_dir) {
+        m_dir = opendir(m_root.c_str());
+    }
+    if (m_dir && !m_pool) {
+        m_pool = std::make_unique<Worker_Pool>(m_threadCount);
+    }
+    return m_dir != nullptr;
+}
+
+void Sysfs_Backend::Close() {
+    if (m_dir) {
+        closedir(m_dir);
+        m_dir = nullptr;
+    }
+    m_pool.reset();
+}
+
+bool Sysfs_Backend::IsOpen() const {
+    return m_dir != nullptr;
+}
+
+unsigned Sysfs_Backend::GetThreadCount() const {
+    return m_threadCount;
+}
+
+//     DDDD:BB:DD.F
+void Sysfs_Backend::ListFunctions(std::vector<PCI_DEVICE_INFO>& devices) {
+    rewinddir(m_dir);
+
+    while (dirent* entry = readdir(m_dir)) {
+        unsigned segment = 0, bus = 0, device = 0, function = 0;
+        if (std::sscanf(entry->d_name, "%x:%x:%x.%x", &segment, &bus, &device, &function) != 4) {
+            continue;
+        }
+
+        //       -   
+        if (segment > UINT16_MAX || !PciFilterBusOverlaps(&m_filter, static_cast<uint8_t>(bus), static_cast<uint8_t>(bus))) {
+            continue;
+        }
+
+        PCI_DEVICE_INFO info{};
+        info.Segment = static_cast<uint16_t>(segment);
+        info.Bus = static_cast<uint8_t>(bus);
+        info.Device = static_cast<uint8_t>(device);
+        info.Function = static_cast<uint8_t>(function);
+        devices.push_back(std::move(info));
+    }
+
+    std::sort(devices.begin(), devices.end(), [](const PCI_DEVICE_INFO& a, const PCI_DEVICE_INFO& b) {
+        return a.GetKey() < b.GetKey();
+    });
+}
+
+//  root sysfs    64  -  .
+//       :     
+bool Sysfs_Backend::ReadFunction(PCI_DEVICE_INFO& device, uint8_t* buffer, size_t size) const {
+    uint64_t start = m_stats ? Scan_Stats::Now() : 0;
+    ssize_t bytesRead = -1;
+    int fd = OpenAttribute(device, "config");
+    if (fd >= 0) {
+        bytesRead = pread(fd, buffer, size, 0);
+        close(fd);
+    }
+
+    bool present = bytesRead >= static_cast<ssize_t>(PCI_Config_Decoder::HeaderSize);
+    if (m_stats) {
+        m_stats->RecordRead(device.Segment, device.Bus, Scan_Stats::Now() - start, !present);
+    }
+    if (!present) {
+        return false;
+    }
+
+    Scan_Phase_Timer decode(m_stats, SCAN_PHASE::Decode);
+    if (!PCI_Config_Decoder::DecodeHeader(buffer, static_cast<size_t>(bytesRead), device) &&
+        !ReadVirtualFunction(device, buffer, static_cast<size_t>(bytesRead))) {
+        return false;
+    }
+
+    device.ConfigSize = static_cast<uint16_t>(bytesRead);
+    return true;
+}
+
+//  VF  config  Vendor ID 0xFFFF;    
+//   vendor  device,   physfn    PF
+bool Sysfs_Backend::ReadVirtualFunction(PCI_DEVICE_INFO& device, const uint8_t* config, size_t size) const {
+    char name[40];
+    auto result = std::format_to_n(name, sizeof(name) - 1, "{:04x}:{:02x}:{:02x}.{:x}/physfn", device.Segment, device.Bus, device.Device, device.Function);
+    *result.out = '\0';
+
+    char target[PATH_MAX];
+    ssize_t length = readlinkat(dirfd(m_dir), name, target, sizeof(target) - 1);
+    if (length <= 0) {
+        return false;
+    }
+    target[length] = '\0';
+
+    unsigned segment = 0, bus = 0, slot = 0, function = 0;
+    const char* base = std::strrchr(target, '/');
+    // PF   VF     - RID    
+    if (std::sscanf(base ? base + 1 : target, "%x:%x:%x.%x", &segment, &bus, &slot, &function) != 4 ||
+        segment != device.Segment) {
+        return false;
+    }
+
+    char vendor[16], deviceId[16];
+    if (ReadAttribute(device, "vendor", vendor, sizeof(vendor)) <= 0 || ReadAttribute(device, "device", deviceId, sizeof(deviceId)) <= 0) {
+        return false;
+    }
+
+    uint32_t id = static_cast<uint32_t>(std::strtoul(vendor, nullptr, 16)) | (static_cast<uint32_t>(std::strtoul(deviceId, nullptr, 16)) << 16);
+    uint16_t physicalFunction = static_cast<uint16_t>((bus << 8) | (slot << 3) | function);
+    return PCI_Config_Decoder::DecodeVirtualFunction(config, size, id, physicalFunction, device);
+}
+
+//    ,        
+//  :    ,      BDF
+void Sysfs_Backend::Enumerate(std::vector<PCI_DEVICE_INFO>& devices) {
+    if (!IsOpen()) {
+        throw std::runtime_error("Sysfs backend not opened");
+    }
+
+    devices.clear();
+    ListFunctions(devices);
+
+    size_t stride = m_captureConfig ? PCI_CFG_EXT_SPACE_SIZE : PCI_Config_Decoder::HeaderSize;
+    m_config.resize(devices.size() * stride);
+    m_valid.assign(devices.size(), 0);
+    ReadRange(devices, 0, devices.size(), stride);
+
+    //    
+    size_t count = 0;
+    for (size_t i = 0; i < devices.size(); ++i) {
+        if (!Accept(devices[i], i, stride)) {
+            continue;
+        }
+        if (count != i) {
+            devices[count] = std::move(devices[i]);
+        }
+        ++count;
+    }
+    devices.resize(count);
+}
+
+//  :          StreamReadAhead ,
+//   ,      ,    
+bool Sysfs_Backend::EnumerateBatches(const PCI_BATCH_CALLBACK& onBatch) {
+    if (!IsOpen()) {
+        throw std::runtime_error("Sysfs backend not opened");
+    }
+
+    std::vector<PCI_DEVICE_INFO> devices;
+    std::vector<PCI_DEVICE_INFO> batch;
+    ListFunctions(devices);
+
+    //     -  Config    
+    size_t stride = m_captureConfig ? PCI_CFG_EXT_SPACE_SIZE : PCI_Config_Decoder::HeaderSize;
+    m_config.resize(devices.size() * stride);
+    m_valid.assign(devices.size(), 0);
+
+    for (size_t begin = 0; begin < devices.size();) {
+        size_t end = begin;
+        do {
+            ++end;
+        } while (end < devices.size() && (end - begin < StreamReadAhead ||
+            (devices[end].Segment == devices[end - 1].Segment && devices[end].Bus == devices[end - 1].Bus)));
+
+        ReadRange(devices, begin, end, stride);
+
+        batch.clear();
+        for (size_t i = begin; i < end; ++i) {
+            if (Accept(devices[i], i, stride)) {
+                batch.push_back(std::move(devices[i]));
+            }
+            bool busEnd = i + 1 == end || devices[i + 1].Segment != devices[i].Segment || devices[i + 1].Bus != devices[i].Bus;
+            if (busEnd && !batch.empty()) {
+                if (!onBatch(batch)) {
+                    return false;
+                }
+                batch.clear();
+            }
+        }
+        begin = end;
+    }
+    return true;
+}
+
+//         
+void Sysfs_Backend::ReadRange(std::vector<PCI_DEVICE_INFO>& devices, size_t begin, size_t end, size_t stride) {
+    auto read = [&](size_t index) {
+        m_valid[begin + index] = ReadFunction(devices[begin + index], m_config.data() + (begin + index) * stride, stride);
+    };
+    if (end - begin < ParallelThreshold) {
+        for (size_t i = 0; i < end - begin; ++i) {
+            read(i);
+        }
+    }
+    else {
+        m_pool->ParallelFor(end - begin, read);
+    }
+}
+
+//          
+bool Sysfs_Backend::Accept(PCI_DEVICE_INFO& device, size_t index, size_t stride) {
+    if (!m_valid[index] || !Matches(device)) {
+        return false;
+    }
+    if (m_captureConfig) {
+        device.Config = m_config.data() + index * stride;
+    }
+    else {
+        device.ConfigSize = 0;
+    }
+    return true;
+}
+
+bool Sysfs_Backend::ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config) {
+    config.resize(PCI_CFG_EXT_SPACE_SIZE);
+
+    int fd = OpenAttribute(device, "config");
+    if (fd < 0) {
+        config.clear();
+        return false;
+    }
+    ssize_t bytesRead = pread(fd, config.data(), config.size(), 0);
+    close(fd);
+
+    config.resize(bytesRead > 0 ? static_cast<size_t>(bytesRead) : 0);
+    return !config.empty();
+}
+
+//  resource:   "start end flags"   ,   - BAR.
+//      64- BAR  
+bool Sysfs_Backend::ReadBarSizes(const PCI_DEVICE_INFO& device, PCI_BAR_SIZES& sizes) {
+    sizes.fill(0);
+
+    int fd = OpenAttribute(device, "resource");
+    if (fd < 0) {
+        return false;
+    }
+
+    char text[1024];
+    ssize_t bytesRead = pread(fd, text, sizeof(text) - 1, 0);
+    close(fd);
+    if (bytesRead <= 0) {
+        return false;
+    }
+    text[bytesRead] = '\0';
+
+    const char* line = text;
+    for (size_t index = 0; index < sizes.size() && *line; ++index) {
+        unsigned long long start = 0;
+        unsigned long long end = 0;
+        if (std::sscanf(line, "%llx %llx", &start, &end) == 2 && end > start) {
+            sizes[index] = end - start + 1;
+        }
+
+        const char* next = std::strchr(line, '\n');
+        if (!next) {
+            break;
+        }
+        line = next + 1;
+    }
+
+    return true;
+}
+
+//    AER     -   
+// ,     .       config
+bool Sysfs_Backend::ReadAerCounters(const PCI_DEVICE_INFO& device, PCI_AER_COUNTERS& counters) {
+    counters = {};
+    if (ReadAerTotal(device, "aer_dev_correctable", "TOTAL_ERR_COR", counters.Correctable) &&
+        ReadAerTotal(device, "aer_dev_nonfatal", "TOTAL_ERR_NONFATAL", counters.NonFatal) &&
+        ReadAerTotal(device, "aer_dev_fatal", "TOTAL_ERR_FATAL", counters.Fatal)) {
+        return true;
+    }
+    return PCI_Backend::ReadAerCounters(device, counters);
+}
+
+//  aer_dev_*:  "<> <>",      TOTAL_ERR_*
+bool Sysfs_Backend::ReadAerTotal(const PCI_DEVICE_INFO& device, const char* attribute, const char* key, uint64_t& total) const {
+    char text[2048];
+    if (ReadAttribute(device, attribute, text, sizeof(text)) <= 0) {
+        return false;
+    }
+
+    const char* found = std::strstr(text, key);
+    if (!found) {
+        return false;
+    }
+    total = std::strtoull(found + std::strlen(key), nullptr, 10);
+    return true;
+}
+
+// numa_node  -1    NUMA.  msi_irqs     
+// MSI/MSI-X     ;      INTx  irq
+bool Sysfs_Backend::ReadLocality(PCI_DEVICE_INFO& device, std::vector<uint32_t>& irqs) {
+    irqs.clear();
+
+    char text[4096];
+    if (ReadAttribute(device, "numa_node", text, sizeof(text)) <= 0) {
+        return false;
+    }
+    device.NumaNode = static_cast<int16_t>(std::strtol(text, nullptr, 10));
+
+    device.LocalCpus.clear();
+    if (ReadAttribute(device, "local_cpulist", text, sizeof(text)) > 0) {
+        device.LocalCpus.assign(text, std::strcspn(text, "\n"));
+    }
+
+    int fd = OpenAttribute(device, "msi_irqs", O_RDONLY | O_DIRECTORY);
+    if (DIR* dir = fd >= 0 ? fdopendir(fd) : nullptr) {
+        while (dirent* entry = readdir(dir)) {
+            char* end = nullptr;
+            unsigned long irq = std::strtoul(entry->d_name, &end, 10);
+            if (end != entry->d_name && *end == '\0') {
+                irqs.push_back(static_cast<uint32_t>(irq));
+            }
+        }
+        closedir(dir);
+    }
+    else if (fd >= 0) {
+        close(fd);
+    }
+    device.MsiVectors = static_cast<uint16_t>(irqs.size());
+
+    if (irqs.empty() && ReadAttribute(device, "irq", text, sizeof(text)) > 0) {
+        unsigned long irq = std::strtoul(text, nullptr, 10);
+        if (irq) {
+            irqs.push_back(static_cast<uint32_t>(irq));
+        }
+    }
+    std::sort(irqs.begin(), irqs.end());
+    return true;
+}
+
+//     ;    
+ssize_t Sysfs_Backend::ReadAttribute(const PCI_DEVICE_INFO& device, const char* attribute, char* text, size_t size) const {
+    int fd = OpenAttribute(device, attribute);
+    if (fd < 0) {
+        return -1;
+    }
+
+    ssize_t bytesRead = pread(fd, text, size - 1, 0);
+    close(fd);
+    text[bytesRead > 0 ? bytesRead : 0] = '\0';
+    return bytesRead;
+}
+
+//     -       
+int Sysfs_Backend::OpenAttribute(const PCI_DEVICE_INFO& device, const char* attribute, int flags) const {
+    if (!m_dir) {
+        return -1;
+    }
+
+    char name[40];
+    auto result = std::format_to_n(name, sizeof(name) - 1, "{:04x}:{:02x}:{:02x}.{:x}/{}", device.Segment, device.Bus, device.Device, device.Function, attribute);
+    *result.out = '\0';
+    return openat(dirfd(m_dir), name, flags | O_CLOEXEC);
+}
+#endif
\ No newline at end of file
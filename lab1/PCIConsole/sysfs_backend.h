@@ -0,0 +1,51 @@
+#pragma once
+#ifndef _WIN32
+#include <memory>
+#include <string>
+#include <vector>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include "pci_backend.h"
+#include "worker_pool.h"
+
+class Sysfs_Backend : public PCI_Backend {
+private:
+    std::string m_root;
+    DIR* m_dir{ nullptr };
+    std::vector<uint8_t> m_config;
+    std::vector<uint8_t> m_valid;
+    unsigned m_threadCount;
+    std::unique_ptr<Worker_Pool> m_pool;
+
+public:
+    static constexpr const char* DefaultRoot = "/sys/bus/pci/devices";
+    static constexpr size_t ParallelThreshold = 64;
+    static constexpr size_t StreamReadAhead = 256;
+
+    explicit Sysfs_Backend(std::string root = DefaultRoot, unsigned threadCount = 0);
+    ~Sysfs_Backend() override;
+
+    bool Open() override;
+    void Close() override;
+    bool IsOpen() const override;
+    void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) override;
+    bool EnumerateBatches(const PCI_BATCH_CALLBACK& onBatch) override;
+    bool ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config) override;
+    bool ReadBarSizes(const PCI_DEVICE_INFO& device, PCI_BAR_SIZES& sizes) override;
+    bool ReadAerCounters(const PCI_DEVICE_INFO& device, PCI_AER_COUNTERS& counters) override;
+    bool ReadLocality(PCI_DEVICE_INFO& device, std::vector<uint32_t>& irqs) override;
+    const char* GetName() const override { return "sysfs"; }
+    unsigned GetThreadCount() const;
+
+private:
+    int OpenAttribute(const PCI_DEVICE_INFO& device, const char* attribute, int flags = O_RDONLY) const;
+    ssize_t ReadAttribute(const PCI_DEVICE_INFO& device, const char* attribute, char* text, size_t size) const;
+    bool ReadAerTotal(const PCI_DEVICE_INFO& device, const char* attribute, const char* key, uint64_t& total) const;
+    void ListFunctions(std::vector<PCI_DEVICE_INFO>& devices);
+    bool ReadFunction(PCI_DEVICE_INFO& device, uint8_t* buffer, size_t size) const;
+    bool ReadVirtualFunction(PCI_DEVICE_INFO& device, const uint8_t* config, size_t size) const;
+    void ReadRange(std::vector<PCI_DEVICE_INFO>& devices, size_t begin, size_t end, size_t stride);
+    bool Accept(PCI_DEVICE_INFO& device, size_t index, size_t stride);
+};
+#endif
\ No newline at end of file
@@ -0,0 +1,147 @@
+#include "tuning_audit.h"
+#include <algorithm>
+#include "config_space.h"
+#include "link_report.h"
+#include "../PCICommon/pci_config.h"
+
+//    128 << n ;   4096 
+uint32_t PCI_Tuning_Audit::GetSizeBytes(uint8_t code) {
+    return 128u << std::min<uint8_t>(code, 5);
+}
+
+//    L0s:  n  " 64 << n ", 7 -  4 
+uint32_t PCI_Tuning_Audit::GetL0sLatency(uint8_t code) {
+    return 64u << code;
+}
+
+//    L1:  n  " 1 << n ", 7 -  64 
+uint32_t PCI_Tuning_Audit::GetL1Latency(uint8_t code) {
+    return 1000u << code;
+}
+
+//   ASPM   Limit ,      
+bool PCI_Tuning_Audit::ExceedsAcceptable(const PCI_TUNING_FINDING& finding) {
+    switch (finding.Issue) {
+    case PCI_TUNING_ISSUE::AspmL0s:
+    case PCI_TUNING_ISSUE::AspmL1:
+        return finding.Limit != 0 && finding.Value > finding.Limit;
+    default:
+        return false;
+    }
+}
+
+// MPS       :     
+//  ,       Malformed TLP.
+// ,     MPS     
+void PCI_Tuning_Audit::AuditPayload(const std::vector<uint32_t>& path) {
+    uint32_t endpoint = path.front();
+    const PCI_LINK_TUNING& tuning = m_states[endpoint].Tuning;
+    uint8_t supported = tuning.PayloadSupported;
+
+    for (uint32_t index : path) {
+        const PCI_LINK_TUNING& hop = m_states[index].Tuning;
+        if (hop.Payload != tuning.Payload) {
+            m_findings.push_back({ endpoint, index, PCI_TUNING_ISSUE::PayloadMismatch,
+                GetSizeBytes(tuning.Payload), GetSizeBytes(hop.Payload) });
+            return;
+        }
+        supported = std::min(supported, hop.PayloadSupported);
+    }
+
+    //     (   )   
+    if (path.size() > 1 && tuning.Payload < supported) {
+        m_findings.push_back({ endpoint, PCI_Topology::None, PCI_TUNING_ISSUE::PayloadBelowPath,
+            GetSizeBytes(tuning.Payload), GetSizeBytes(supported) });
+    }
+}
+
+//    -  ",  "     .
+//   L1        1    
+//    ; L0s     
+void PCI_Tuning_Audit::AuditAspm(const std::vector<uint32_t>& path) {
+    uint32_t endpoint = path.front();
+    const PCI_LINK_TUNING& tuning = m_states[endpoint].Tuning;
+    uint32_t l0s = 0, l0sAt = PCI_Topology::None;
+    uint32_t l1 = 0, l1At = PCI_Topology::None;
+    uint32_t hops = 0;
+
+    for (size_t i = 0; i + 1 < path.size(); ++i) {
+        const PCI_LINK_TUNING& up = m_states[path[i]].Tuning;
+        const PCI_LINK_TUNING& down = m_states[path[i + 1]].Tuning;
+        if (PCI_Link_Report::IsDownstreamPort(up.PortType) || !PCI_Link_Report::IsDownstreamPort(down.PortType)) {
+            continue;
+        }
+
+        for (const PCI_LINK_TUNING* end : { &up, &down }) {
+            if ((end->AspmEnabled & PCI_EXP_ASPM_L0S) && GetL0sLatency(end->L0sExitLatency) > l0s) {
+                l0s = GetL0sLatency(end->L0sExitLatency);
+                l0sAt = path[i + 1];
+            }
+        }
+
+        if ((up.AspmEnabled | down.AspmEnabled) & PCI_EXP_ASPM_L1) {
+            uint32_t latency = std::max(GetL1Latency(up.L1ExitLatency), GetL1Latency(down.L1ExitLatency)) + hops * 1000;
+            if (latency > l1) {
+                l1 = latency;
+                l1At = path[i + 1];
+            }
+        }
+        hops++;
+    }
+
+    //  7     - " "
+    if (l0sAt != PCI_Topology::None) {
+        uint32_t limit = tuning.L0sAcceptable == 7 ? 0 : GetL0sLatency(tuning.L0sAcceptable);
+        m_findings.push_back({ endpoint, l0sAt, PCI_TUNING_ISSUE::AspmL0s, l0s, limit });
+    }
+    if (l1At != PCI_Topology::None) {
+        uint32_t limit = tuning.L1Acceptable == 7 ? 0 : GetL1Latency(tuning.L1Acceptable);
+        m_findings.push_back({ endpoint, l1At, PCI_TUNING_ISSUE::AspmL1, l1, limit });
+    }
+}
+
+//           
+// ,      -    
+//  ,      .
+// VF : MPS, MRRS  Relaxed Ordering   RsvdP,   PF
+void PCI_Tuning_Audit::Build(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology) {
+    m_states.assign(devices.size(), {});
+    m_findings.clear();
+    m_endpoints = 0;
+
+    for (size_t i = 0; i < devices.size(); ++i) {
+        PCI_Config_Space config(devices[i]);
+        m_states[i].Present = config.GetTuning(m_states[i].Tuning);
+    }
+
+    std::vector<uint32_t> path;
+    for (uint32_t i = 0; i < m_states.size(); ++i) {
+        if (!m_states[i].Present || devices[i].Virtual || (devices[i].HeaderType & PCI_HEADER_TYPE_MASK) != PCI_HEADER_TYPE_NORMAL) {
+            continue;
+        }
+        m_endpoints++;
+
+        path.assign(1, i);
+        for (uint32_t parent = topology.GetNode(i).Parent; parent != PCI_Topology::None && m_states[parent].Present;
+            parent = topology.GetNode(parent).Parent) {
+            path.push_back(parent);
+            if (m_states[parent].Tuning.PortType == PCI_EXP_TYPE_ROOT_PORT) {
+                break;
+            }
+        }
+
+        const PCI_LINK_TUNING& tuning = m_states[i].Tuning;
+        AuditPayload(path);
+        if (GetSizeBytes(tuning.ReadRequest) < MinReadRequest) {
+            m_findings.push_back({ i, PCI_Topology::None, PCI_TUNING_ISSUE::SmallReadRequest,
+                GetSizeBytes(tuning.ReadRequest), MinReadRequest });
+        }
+        AuditAspm(path);
+
+        // Relaxed Ordering      DMA     
+        bool bulkDma = devices[i].BaseClass == 0x01 || devices[i].BaseClass == 0x02;
+        if (bulkDma && !tuning.RelaxedOrdering) {
+            m_findings.push_back({ i, PCI_Topology::None, PCI_TUNING_ISSUE::RelaxedOrderingOff, 0, 0 });
+        }
+    }
+}
\ No newline at end of file
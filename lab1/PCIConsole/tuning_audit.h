@@ -0,0 +1,54 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "pci_device_info.h"
+#include "pci_link.h"
+#include "pci_topology.h"
+
+enum class PCI_TUNING_ISSUE {
+    PayloadMismatch,
+    PayloadBelowPath,
+    SmallReadRequest,
+    AspmL0s,
+    AspmL1,
+    RelaxedOrderingOff
+};
+
+struct PCI_TUNING_STATE {
+    bool Present{ false };
+    PCI_LINK_TUNING Tuning{};
+};
+
+struct PCI_TUNING_FINDING {
+    uint32_t Index;
+    uint32_t Peer;
+    PCI_TUNING_ISSUE Issue;
+    uint32_t Value;
+    uint32_t Limit;
+};
+
+class PCI_Tuning_Audit {
+private:
+    std::vector<PCI_TUNING_STATE> m_states;
+    std::vector<PCI_TUNING_FINDING> m_findings;
+    size_t m_endpoints{ 0 };
+
+public:
+    static constexpr uint32_t MinReadRequest = 512;
+
+    void Build(const std::vector<PCI_DEVICE_INFO>& devices, const PCI_Topology& topology);
+
+    const PCI_TUNING_STATE& GetState(uint32_t index) const { return m_states[index]; }
+    const std::vector<PCI_TUNING_FINDING>& GetFindings() const { return m_findings; }
+    size_t GetEndpointCount() const { return m_endpoints; }
+
+    static uint32_t GetSizeBytes(uint8_t code);
+    static uint32_t GetL0sLatency(uint8_t code);
+    static uint32_t GetL1Latency(uint8_t code);
+    static bool ExceedsAcceptable(const PCI_TUNING_FINDING& finding);
+
+private:
+    void AuditPayload(const std::vector<uint32_t>& path);
+    void AuditAspm(const std::vector<uint32_t>& path);
+};
\ No newline at end of file
@@ -0,0 +1,88 @@
+#include "worker_pool.h"
+#include <algorithm>
+
+//     ,      
+Worker_Pool::Worker_Pool(unsigned threadCount) {
+    for (unsigned i = 1; i < threadCount; ++i) {
+        m_threads.emplace_back(&Worker_Pool::WorkerLoop, this);
+    }
+}
+
+Worker_Pool::~Worker_Pool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+unsigned Worker_Pool::GetThreadCount() const {
+    return static_cast<unsigned>(m_threads.size()) + 1;
+}
+
+//        ,    CPU -
+//      
+unsigned Worker_Pool::GetDefaultThreadCount() {
+    unsigned hardware = std::thread::hardware_concurrency();
+    return std::clamp(hardware, 1u, 8u);
+}
+
+//    ;       ,
+//         
+void Worker_Pool::ParallelFor(size_t count, const std::function<void(size_t)>& task) {
+    if (m_threads.empty() || count < 2) {
+        for (size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_count = count;
+        m_next.store(0, std::memory_order_relaxed);
+        m_active = m_threads.size();
+        ++m_round;
+    }
+    m_wake.notify_all();
+
+    RunTasks();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_active == 0; });
+    m_task = nullptr;
+}
+
+void Worker_Pool::WorkerLoop() {
+    uint64_t seen = 0;
+
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_round != seen; });
+            if (m_stop) {
+                return;
+            }
+            seen = m_round;
+        }
+
+        RunTasks();
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_active == 0) {
+            m_done.notify_one();
+        }
+    }
+}
+
+void Worker_Pool::RunTasks() {
+    for (size_t i = m_next.fetch_add(1, std::memory_order_relaxed); i < m_count;
+        i = m_next.fetch_add(1, std::memory_order_relaxed)) {
+        (*m_task)(i);
+    }
+}
\ No newline at end of file
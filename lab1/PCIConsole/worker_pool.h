@@ -0,0 +1,39 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Worker_Pool {
+private:
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(size_t)>* m_task{ nullptr };
+    std::atomic<size_t> m_next{ 0 };
+    size_t m_count{ 0 };
+    size_t m_active{ 0 };
+    uint64_t m_round{ 0 };
+    bool m_stop{ false };
+
+public:
+    explicit Worker_Pool(unsigned threadCount);
+    ~Worker_Pool();
+
+    Worker_Pool(const Worker_Pool&) = delete;
+    Worker_Pool& operator=(const Worker_Pool&) = delete;
+
+    unsigned GetThreadCount() const;
+    void ParallelFor(size_t count, const std::function<void(size_t)>& task);
+
+    static unsigned GetDefaultThreadCount();
+
+private:
+    void WorkerLoop();
+    void RunTasks();
+};
\ No newline at end of file
@@ -1,180 +1,348 @@
 #include <wdm.h>
-#include <ntstrsafe.h>
+#include "../PCICommon/pci_walk.h"
+#include "../PCICommon/pci_wire.h"
+#include "../PCICommon/pci_ring.h"
 
 #define PCI_CONFIG_ADDRESS 0xCF8
 #define PCI_CONFIG_DATA    0xCFC
 #define DEVICE_NAME L"\\Device\\PCIScanner"
 #define SYMBOLIC_NAME L"\\DosDevices\\PCIScanner"
-
-#define IOCTL_PCI_GET_DEVICES CTL_CODE(FILE_DEVICE_UNKNOWN, 0x800, METHOD_BUFFERED, FILE_ANY_ACCESS)
-
-typedef struct _PCI_DEVICE_INFO {
-    UCHAR Bus;
-    UCHAR Device;
-    UCHAR Function;
-    USHORT VendorID;
-    USHORT DeviceID;
-    UCHAR BaseClass;
-    UCHAR SubClass;
-    UCHAR Revision;
-    char Description[64];
-} PCI_DEVICE_INFO, * PPCI_DEVICE_INFO;
-
-typedef struct _PCI_DEVICE_LIST {
-    ULONG NumberOfDevices;
-    PCI_DEVICE_INFO Devices[32];
-} PCI_DEVICE_LIST, * PPCI_DEVICE_LIST;
+#define PCI_RING_TAG 'gnRP'
+#define PCI_RING_DRIVER_CAPACITY 4096
+#define PCI_RING_WAIT_INTERVAL 1000
+#define PCI_RING_STALL_LIMIT 20000
 
 DRIVER_UNLOAD UnloadDriver;
 DRIVER_DISPATCH DispatchCreateClose;
+DRIVER_DISPATCH DispatchCleanup;
 DRIVER_DISPATCH DispatchDeviceControl;
 
-//     Class/Subclass
-const char* GetDeviceType(UCHAR base_class, UCHAR sub_class) {
-    UNREFERENCED_PARAMETER(base_class);
-    UNREFERENCED_PARAMETER(sub_class);
-
-    switch (base_class) {
-    case 0x00: return "Pre-2.0 Device";
-    case 0x01:
-        switch (sub_class) {
-        case 0x00: return "SCSI Controller";
-        case 0x01: return "IDE Controller";
-        case 0x02: return "Floppy Controller";
-        case 0x03: return "IPI Controller";
-        case 0x04: return "RAID Controller";
-        case 0x05: return "ATA Controller";
-        case 0x06: return "SATA Controller";
-        case 0x80: return "Other Mass Storage";
-        default: return "Mass Storage Controller";
-        }
-    case 0x02:
-        switch (sub_class) {
-        case 0x00: return "Ethernet Controller";
-        case 0x01: return "Token Ring Controller";
-        case 0x02: return "FDDI Controller";
-        case 0x03: return "ATM Controller";
-        case 0x04: return "ISDN Controller";
-        case 0x80: return "Other Network Controller";
-        default: return "Network Controller";
-        }
-    case 0x03:
-        switch (sub_class) {
-        case 0x00: return "VGA Compatible Controller";
-        case 0x01: return "XGA Controller";
-        case 0x02: return "3D Controller";
-        case 0x80: return "Other Display Controller";
-        default: return "Display Controller";
-        }
-    case 0x06:
-        switch (sub_class) {
-        case 0x00: return "Host Bridge";
-        case 0x01: return "ISA Bridge";
-        case 0x02: return "EISA Bridge";
-        case 0x03: return "MCA Bridge";
-        case 0x04: return "PCI-to-PCI Bridge";
-        case 0x05: return "PCMCIA Bridge";
-        case 0x06: return "NuBus Bridge";
-        case 0x07: return "CardBus Bridge";
-        case 0x08: return "RACEway Bridge";
-        case 0x80: return "Other Bridge";
-        default: return "Bridge Device";
+//     CF8 /  CFC  :  IOCTL  
+//    .       
+static KSPIN_LOCK PciConfigLock;
+
+//  dword    CF8/CFC    
+static void ReadPciConfigBurst(uint8_t bus, uint8_t device, uint8_t function, uint16_t offset, uint16_t count, uint32_t* data) {
+    ULONG address = (1UL << 31) | ((ULONG)bus << 16) | ((ULONG)device << 11) | ((ULONG)function << 8);
+    KIRQL irql;
+    uint16_t i;
+
+    KeAcquireSpinLock(&PciConfigLock, &irql);
+    for (i = 0; i < count; i++) {
+        WRITE_PORT_ULONG((PULONG)PCI_CONFIG_ADDRESS, address | ((offset + i * 4u) & 0xFC));
+        data[i] = READ_PORT_ULONG((PULONG)PCI_CONFIG_DATA);
+    }
+    KeReleaseSpinLock(&PciConfigLock, irql);
+}
+
+static uint32_t ReadPciConfig(void* context, uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
+    uint32_t value;
+    UNREFERENCED_PARAMETER(context);
+
+    ReadPciConfigBurst(bus, device, function, offset, 1, &value);
+    return value;
+}
+
+//  64-     -    
+static void ReadPciHeader(void* context, uint8_t bus, uint8_t device, uint8_t function, uint32_t* header) {
+    UNREFERENCED_PARAMETER(context);
+
+    ReadPciConfigBurst(bus, device, function, 0, PCI_CFG_HEADER_DWORDS, header);
+}
+
+typedef struct _PCI_SCAN_OUTPUT {
+    PVOID Buffer;
+    ULONG BufferSize;
+    USHORT ConfigSize;
+} PCI_SCAN_OUTPUT, * PPCI_SCAN_OUTPUT;
+
+//    ;   
+//        
+static void FillFunctionConfig(const PCI_WALK_FUNCTION* function, uint8_t* config, USHORT configSize) {
+    RtlCopyMemory(config, function->Header, PCI_CFG_HEADER_SIZE);
+    if (configSize > PCI_CFG_HEADER_SIZE) {
+        ReadPciConfigBurst(function->Bus, function->Device, function->Function, PCI_CFG_HEADER_SIZE,
+            (uint16_t)((configSize - PCI_CFG_HEADER_SIZE) / 4), (uint32_t*)(config + PCI_CFG_HEADER_SIZE));
+    }
+}
+
+static int StorePciFunction(void* context, const PCI_WALK_FUNCTION* function) {
+    PPCI_SCAN_OUTPUT output = (PPCI_SCAN_OUTPUT)context;
+    PCI_WIRE_RECORD record;
+    uint8_t* config;
+
+    PciWireFillRecord(&record, function);
+
+    //      ,     
+    config = PciWireAppend(output->Buffer, output->BufferSize, &record);
+    if (config) {
+        FillFunctionConfig(function, config, output->ConfigSize);
+    }
+    return 1;
+}
+
+static USHORT ClampConfigSize(USHORT configSize, USHORT limit) {
+    if (configSize > limit) {
+        configSize = limit;
+    }
+    if (configSize < PCI_CFG_HEADER_SIZE) {
+        configSize = PCI_CFG_HEADER_SIZE;
+    }
+    return (USHORT)(configSize & ~3u);
+}
+
+//     0    .
+//  CF8/CFC    256   :
+// capability SR-IOV  ARI ,  VF  ,    
+//  ARI Forwarding    256  .
+//     - user space     
+NTSTATUS ScanPciDevices(PVOID buffer, ULONG bufferSize, USHORT configSize, const PCI_FILTER* filter, PULONG bytesWritten) {
+    PCI_WALK_OPS ops = { 0 };
+    PCI_WALK_STATS stats = { 0 };
+    PCI_SCAN_OUTPUT output;
+    PPCI_WIRE_HEADER header = (PPCI_WIRE_HEADER)buffer;
+
+    configSize = ClampConfigSize(configSize, PCI_CFG_SPACE_SIZE);
+
+    output.Buffer = buffer;
+    output.BufferSize = bufferSize;
+    output.ConfigSize = configSize;
+    PciWireBegin(buffer, configSize);
+
+    ops.ReadConfig = ReadPciConfig;
+    ops.ReadHeader = ReadPciHeader;
+    ops.Filter = filter;
+    ops.Visit = StorePciFunction;
+    ops.Context = &output;
+
+    PciWalkTopology(&ops, &stats);
+
+    KdPrint(("PCISCAN: %u functions on %u buses, %u config reads\n",
+        stats.FunctionsFound, stats.BusesScanned, stats.ConfigReads));
+
+    *bytesWritten = PciWireUsedSize(buffer);
+
+    //   ( ..  ) -   TotalCount     user space
+    return (header->RecordCount < header->TotalCount) ? STATUS_BUFFER_OVERFLOW : STATUS_SUCCESS;
+}
+
+//     (FileObject->FsContext).   
+//           Ring
+typedef struct _PCI_RING_CONTEXT {
+    PMDL Mdl;
+    PVOID SystemAddress;
+    PVOID UserAddress;
+    ULONG Size;
+    volatile LONG Busy;
+    volatile LONG Abandoned;
+    USHORT ScanConfigSize;
+    uint32_t ScanState;
+    PCI_RING Ring;
+} PCI_RING_CONTEXT, * PPCI_RING_CONTEXT;
+
+//    ;     ,
+//    PCI_RING_STALL_LIMIT  -    
+static int StoreRingFunction(void* context, const PCI_WALK_FUNCTION* function) {
+    PPCI_RING_CONTEXT ring = (PPCI_RING_CONTEXT)context;
+    PCI_WIRE_RECORD* record;
+    LARGE_INTEGER interval;
+    ULONG waits = 0;
+
+    interval.QuadPart = -PCI_RING_WAIT_INTERVAL;
+
+    while ((record = PciRingReserve(&ring->Ring)) == NULL) {
+        if (ring->Abandoned || PciRingIsCancelled(&ring->Ring)) {
+            return 0;
         }
-    case 0x0C:
-        switch (sub_class) {
-        case 0x00: return "Serial Controller";
-        case 0x01: return "Parallel Controller";
-        case 0x02: return "Multiport Serial Controller";
-        case 0x03: return "Modem";
-        case 0x80: return "Other Communications";
-        default: return "Communications Controller";
+        if (++waits > PCI_RING_STALL_LIMIT) {
+            ring->ScanState = PCI_RING_STALLED;
+            return 0;
         }
-    default: return "Unknown Device";
+        KeDelayExecutionThread(KernelMode, FALSE, &interval);
+    }
+    if (PciRingIsCancelled(&ring->Ring)) {
+        return 0;
     }
+
+    PciWireFillRecord(record, function);
+    FillFunctionConfig(function, PciRingRecordConfig(&ring->Ring, record), ring->ScanConfigSize);
+    PciRingCommit(&ring->Ring);
+    return 1;
 }
 
-//    VendorID
-const char* GetVendorName(USHORT vendor_id) {
-    UNREFERENCED_PARAMETER(vendor_id);
-
-    switch (vendor_id) {
-    case 0x8086: return "Intel";
-    case 0x10DE: return "NVIDIA";
-    case 0x1002: return "AMD";
-    case 0x1414: return "Microsoft";
-    case 0x5333: return "S3";
-    case 0x1011: return "Digital Equipment";
-    case 0x10EC: return "Realtek";
-    case 0x1969: return "Atheros";
-    default: return "Unknown Vendor";
+//   ,        ,   
+NTSTATUS ScanPciRing(PPCI_RING_CONTEXT context, USHORT configSize, const PCI_FILTER* filter) {
+    PCI_WALK_OPS ops = { 0 };
+    PCI_WALK_STATS stats = { 0 };
+
+    context->ScanConfigSize = ClampConfigSize(configSize, context->Ring.ConfigSize);
+    context->ScanState = PCI_RING_DONE;
+    PciRingBegin(&context->Ring);
+
+    ops.ReadConfig = ReadPciConfig;
+    ops.ReadHeader = ReadPciHeader;
+    ops.Filter = filter;
+    ops.Visit = StoreRingFunction;
+    ops.Context = context;
+
+    PciWalkTopology(&ops, &stats);
+    PciRingFinish(&context->Ring, context->ScanState);
+
+    KdPrint(("PCISCAN: %u functions to ring (%u published), %u config reads\n",
+        stats.FunctionsFound, context->Ring.Count, stats.ConfigReads));
+
+    return (context->ScanState == PCI_RING_STALLED) ? STATUS_IO_TIMEOUT : STATUS_SUCCESS;
+}
+
+//      - (IRP_MJ_CLEANUP)
+static void UnmapPciRingUser(PPCI_RING_CONTEXT context) {
+    if (context->UserAddress) {
+        MmUnmapLockedPages(context->UserAddress, context->Mdl);
+        context->UserAddress = NULL;
     }
 }
 
-NTSTATUS ScanPciDevices(PPCI_DEVICE_LIST deviceList) {
-    UCHAR bus, device, function;
-    ULONG devices_found = 0;
-
-    for (bus = 0; bus < 2; bus++) {
-        for (device = 0; device < 32; device++) {
-            for (function = 0; function < 8; function++) {
-                ULONG address = (1 << 31) | (bus << 16) | (device << 11) | (function << 8);
-                WRITE_PORT_ULONG((PULONG)PCI_CONFIG_ADDRESS, address);
-                ULONG vendor_device = READ_PORT_ULONG((PULONG)PCI_CONFIG_DATA);
-
-                USHORT vendor_id = (USHORT)(vendor_device & 0xFFFF);
-                USHORT device_id = (USHORT)((vendor_device >> 16) & 0xFFFF);
-
-                if (vendor_id != 0xFFFF) {
-                    //  Class Code  Revision
-                    WRITE_PORT_ULONG((PULONG)PCI_CONFIG_ADDRESS, address | 0x08);
-                    ULONG class_rev = READ_PORT_ULONG((PULONG)PCI_CONFIG_DATA);
-                    UCHAR revision = (UCHAR)(class_rev & 0xFF);
-                    UCHAR sub_class = (UCHAR)((class_rev >> 16) & 0xFF);
-                    UCHAR base_class = (UCHAR)((class_rev >> 24) & 0xFF);
-
-                    //    
-                    PPCI_DEVICE_INFO devInfo = &deviceList->Devices[devices_found];
-                    devInfo->Bus = bus;
-                    devInfo->Device = device;
-                    devInfo->Function = function;
-                    devInfo->VendorID = vendor_id;
-                    devInfo->DeviceID = device_id;
-                    devInfo->BaseClass = base_class;
-                    devInfo->SubClass = sub_class;
-                    devInfo->Revision = revision;
-
-                    //  
-                    const char* vendor_name = GetVendorName(vendor_id);
-                    const char* device_type = GetDeviceType(base_class, sub_class);
-
-                    //  
-                    NTSTATUS status;
-                    status = RtlStringCbPrintfA(devInfo->Description, sizeof(devInfo->Description),
-                        "%s %s", vendor_name, device_type);
-
-                    //   
-                    if (!NT_SUCCESS(status)) {
-                        RtlStringCbCopyA(devInfo->Description, sizeof(devInfo->Description), "Unknown Device");
-                    }
-
-                    devices_found++;
-
-                    if (devices_found >= 32) {
-                        deviceList->NumberOfDevices = devices_found;
-                        return STATUS_SUCCESS;
-                    }
-                }
-            }
-        }
+static void FreePciRing(PPCI_RING_CONTEXT context) {
+    UnmapPciRingUser(context);
+    if (context->SystemAddress) {
+        MmUnmapLockedPages(context->SystemAddress, context->Mdl);
     }
+    if (context->Mdl) {
+        MmFreePagesFromMdl(context->Mdl);
+        ExFreePool(context->Mdl);
+    }
+    ExFreePoolWithTag(context, PCI_RING_TAG);
+}
+
+static uint32_t RoundRingCapacity(uint32_t capacity) {
+    uint32_t rounded = 1;
 
-    deviceList->NumberOfDevices = devices_found;
+    if (capacity == 0 || capacity > PCI_RING_DRIVER_CAPACITY) {
+        return PCI_RING_DRIVER_CAPACITY;
+    }
+    while (rounded < capacity) {
+        rounded <<= 1;
+    }
+    return rounded;
+}
+
+//    ,       
+//  ,       
+NTSTATUS MapPciRing(PFILE_OBJECT fileObject, const PCI_RING_MAP_REQUEST* request, PPCI_RING_MAP_RESPONSE response) {
+    PHYSICAL_ADDRESS low, high, skip;
+    PPCI_RING_CONTEXT context;
+    uint32_t capacity = RoundRingCapacity(request->Capacity);
+    USHORT configSize = ClampConfigSize(request->ConfigSize, PCI_CFG_SPACE_SIZE);
+
+    if (request->Version != PCI_RING_VERSION) {
+        return STATUS_REVISION_MISMATCH;
+    }
+    if (fileObject->FsContext) {
+        return STATUS_ALREADY_COMMITTED;
+    }
+
+    context = (PPCI_RING_CONTEXT)ExAllocatePool2(POOL_FLAG_NON_PAGED, sizeof(PCI_RING_CONTEXT), PCI_RING_TAG);
+    if (!context) {
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+    RtlZeroMemory(context, sizeof(PCI_RING_CONTEXT));
+
+    low.QuadPart = 0;
+    high.QuadPart = -1;
+    skip.QuadPart = 0;
+    context->Size = (ULONG)ROUND_TO_PAGES(PciRingSize(capacity, configSize));
+    context->Mdl = MmAllocatePagesForMdlEx(low, high, skip, context->Size, MmCached, MM_ALLOCATE_FULLY_REQUIRED);
+    if (context->Mdl) {
+        context->SystemAddress = MmGetSystemAddressForMdlSafe(context->Mdl, NormalPagePriority | MdlMappingNoExecute);
+    }
+    if (!context->SystemAddress) {
+        FreePciRing(context);
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    PciRingInit(&context->Ring, context->SystemAddress, context->Size, capacity, configSize);
+
+    __try {
+        context->UserAddress = MmMapLockedPagesSpecifyCache(context->Mdl, UserMode, MmCached, NULL, FALSE,
+            NormalPagePriority | MdlMappingNoExecute);
+    }
+    __except (EXCEPTION_EXECUTE_HANDLER) {
+        context->UserAddress = NULL;
+    }
+    if (!context->UserAddress) {
+        FreePciRing(context);
+        return STATUS_INSUFFICIENT_RESOURCES;
+    }
+
+    //         
+    if (InterlockedCompareExchangePointer(&fileObject->FsContext, context, NULL) != NULL) {
+        FreePciRing(context);
+        return STATUS_ALREADY_COMMITTED;
+    }
+
+    response->Address = (uint64_t)(ULONG_PTR)context->UserAddress;
+    response->Size = context->Size;
+    response->Reserved = 0;
+
+    KdPrint(("PCISCAN: ring mapped, %u records of %u bytes\n", capacity, (ULONG)context->Ring.RecordSize));
     return STATUS_SUCCESS;
 }
 
+//  ; METHOD_BUFFERED       ,
+//       .
+//      -     
+static NTSTATUS ReadScanRequest(PIRP Irp, PIO_STACK_LOCATION irpStack, USHORT* configSize, PCI_FILTER* filter) {
+    ULONG inputLength = irpStack->Parameters.DeviceIoControl.InputBufferLength;
+    PCI_WIRE_REQUEST request;
+
+    if (inputLength < sizeof(PCI_WIRE_REQUEST)) {
+        return STATUS_SUCCESS;
+    }
+
+    request = *(PPCI_WIRE_REQUEST)Irp->AssociatedIrp.SystemBuffer;
+    if (request.Version != PCI_WIRE_VERSION) {
+        return STATUS_REVISION_MISMATCH;
+    }
+    if (request.Flags & PCI_WIRE_FLAG_CONFIG) {
+        *configSize = request.ConfigSize;
+    }
+    if (request.Flags & PCI_WIRE_FLAG_FILTER) {
+        if (inputLength < sizeof(PCI_WIRE_REQUEST) + sizeof(PCI_FILTER)) {
+            return STATUS_INVALID_PARAMETER;
+        }
+        *filter = *(PPCI_FILTER)((PUCHAR)Irp->AssociatedIrp.SystemBuffer + sizeof(PCI_WIRE_REQUEST));
+    }
+    return STATUS_SUCCESS;
+}
+
+// CLOSE        -   
 NTSTATUS DispatchCreateClose(PDEVICE_OBJECT DeviceObject, PIRP Irp) {
     UNREFERENCED_PARAMETER(DeviceObject);
 
+    PIO_STACK_LOCATION irpStack = IoGetCurrentIrpStackLocation(Irp);
+    if (irpStack->MajorFunction == IRP_MJ_CLOSE && irpStack->FileObject && irpStack->FileObject->FsContext) {
+        FreePciRing((PPCI_RING_CONTEXT)irpStack->FileObject->FsContext);
+        irpStack->FileObject->FsContext = NULL;
+    }
+
+    Irp->IoStatus.Status = STATUS_SUCCESS;
+    Irp->IoStatus.Information = 0;
+    IoCompleteRequest(Irp, IO_NO_INCREMENT);
+    return STATUS_SUCCESS;
+}
+
+//   :   ,  ,
+//     
+NTSTATUS DispatchCleanup(PDEVICE_OBJECT DeviceObject, PIRP Irp) {
+    UNREFERENCED_PARAMETER(DeviceObject);
+
+    PIO_STACK_LOCATION irpStack = IoGetCurrentIrpStackLocation(Irp);
+    PPCI_RING_CONTEXT context = irpStack->FileObject ? (PPCI_RING_CONTEXT)irpStack->FileObject->FsContext : NULL;
+    if (context) {
+        InterlockedExchange(&context->Abandoned, 1);
+        UnmapPciRingUser(context);
+    }
+
     Irp->IoStatus.Status = STATUS_SUCCESS;
     Irp->IoStatus.Information = 0;
     IoCompleteRequest(Irp, IO_NO_INCREMENT);
@@ -190,16 +358,61 @@ NTSTATUS DispatchDeviceControl(PDEVICE_OBJECT DeviceObject, PIRP Irp) {
 
     switch (irpStack->Parameters.DeviceIoControl.IoControlCode) {
     case IOCTL_PCI_GET_DEVICES: {
-        if (irpStack->Parameters.DeviceIoControl.OutputBufferLength >= sizeof(PCI_DEVICE_LIST)) {
-            PPCI_DEVICE_LIST deviceList = (PPCI_DEVICE_LIST)Irp->AssociatedIrp.SystemBuffer;
-            status = ScanPciDevices(deviceList);
-            infoLength = sizeof(PCI_DEVICE_LIST);
+        USHORT configSize = 0;
+        PCI_FILTER filter = { 0 };
+        status = ReadScanRequest(Irp, irpStack, &configSize, &filter);
+        if (!NT_SUCCESS(status)) {
+            break;
+        }
+
+        if (irpStack->Parameters.DeviceIoControl.OutputBufferLength >= sizeof(PCI_WIRE_HEADER)) {
+            status = ScanPciDevices(Irp->AssociatedIrp.SystemBuffer,
+                irpStack->Parameters.DeviceIoControl.OutputBufferLength, configSize, &filter, &infoLength);
         }
         else {
             status = STATUS_BUFFER_TOO_SMALL;
         }
         break;
     }
+    case IOCTL_PCI_MAP_RING: {
+        PCI_RING_MAP_REQUEST request;
+        if (irpStack->Parameters.DeviceIoControl.InputBufferLength < sizeof(PCI_RING_MAP_REQUEST) ||
+            irpStack->Parameters.DeviceIoControl.OutputBufferLength < sizeof(PCI_RING_MAP_RESPONSE)) {
+            status = STATUS_BUFFER_TOO_SMALL;
+            break;
+        }
+
+        request = *(PPCI_RING_MAP_REQUEST)Irp->AssociatedIrp.SystemBuffer;
+        status = MapPciRing(irpStack->FileObject, &request, (PPCI_RING_MAP_RESPONSE)Irp->AssociatedIrp.SystemBuffer);
+        if (NT_SUCCESS(status)) {
+            infoLength = sizeof(PCI_RING_MAP_RESPONSE);
+        }
+        break;
+    }
+    case IOCTL_PCI_SCAN_RING: {
+        //   ,   IOCTL_PCI_GET_DEVICES;    ,    
+        PPCI_RING_CONTEXT context = (PPCI_RING_CONTEXT)irpStack->FileObject->FsContext;
+        USHORT configSize = 0;
+        PCI_FILTER filter = { 0 };
+        if (!context) {
+            status = STATUS_INVALID_DEVICE_REQUEST;
+            break;
+        }
+
+        status = ReadScanRequest(Irp, irpStack, &configSize, &filter);
+        if (!NT_SUCCESS(status)) {
+            break;
+        }
+
+        //     -       
+        if (InterlockedCompareExchange(&context->Busy, 1, 0) != 0) {
+            status = STATUS_DEVICE_BUSY;
+            break;
+        }
+        status = ScanPciRing(context, configSize, &filter);
+        InterlockedExchange(&context->Busy, 0);
+        break;
+    }
     default:
         status = STATUS_INVALID_DEVICE_REQUEST;
         break;
@@ -230,6 +443,8 @@ NTSTATUS DriverEntry(PDRIVER_OBJECT DriverObject, PUNICODE_STRING RegistryPath)
     PDEVICE_OBJECT deviceObject = NULL;
     UNICODE_STRING deviceName, symbolicName;
 
+    KeInitializeSpinLock(&PciConfigLock);
+
     //  
     RtlInitUnicodeString(&deviceName, DEVICE_NAME);
     RtlInitUnicodeString(&symbolicName, SYMBOLIC_NAME);
@@ -253,6 +468,7 @@ NTSTATUS DriverEntry(PDRIVER_OBJECT DriverObject, PUNICODE_STRING RegistryPath)
     DriverObject->DriverUnload = UnloadDriver;
     DriverObject->MajorFunction[IRP_MJ_CREATE] = DispatchCreateClose;
     DriverObject->MajorFunction[IRP_MJ_CLOSE] = DispatchCreateClose;
+    DriverObject->MajorFunction[IRP_MJ_CLEANUP] = DispatchCleanup;
     DriverObject->MajorFunction[IRP_MJ_DEVICE_CONTROL] = DispatchDeviceControl;
 
     DbgPrint("PCISCAN: Driver loaded successfully\n");
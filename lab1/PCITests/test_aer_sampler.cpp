@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <vector>
+#include "aer_sampler.h"
+#include "test_check.h"
+
+//        ;   - Bus
+class Scripted_Backend : public PCI_Backend {
+private:
+    std::vector<std::vector<PCI_AER_COUNTERS>> m_scripts;
+    std::vector<size_t> m_positions;
+
+public:
+    explicit Scripted_Backend(std::vector<std::vector<PCI_AER_COUNTERS>> scripts)
+        : m_scripts(std::move(scripts)), m_positions(m_scripts.size(), 0) {
+    }
+
+    bool Open() override { return true; }
+    void Close() override {}
+    bool IsOpen() const override { return true; }
+    void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) override { devices.clear(); }
+    const char* GetName() const override { return "scripted"; }
+
+    bool ReadAerCounters(const PCI_DEVICE_INFO& device, PCI_AER_COUNTERS& counters) override {
+        const auto& script = m_scripts[device.Bus];
+        size_t& position = m_positions[device.Bus];
+        if (script.empty()) {
+            return false;
+        }
+        counters = script[std::min(position++, script.size() - 1)];
+        return true;
+    }
+};
+
+static PCI_AER_COUNTERS Status(uint64_t correctable, uint64_t nonFatal, uint64_t fatal) {
+    return { correctable, nonFatal, fatal, true };
+}
+
+static PCI_AER_COUNTERS Totals(uint64_t correctable, uint64_t nonFatal, uint64_t fatal) {
+    return { correctable, nonFatal, fatal, false };
+}
+
+static PCI_DEVICE_INFO MakeDevice(uint8_t bus) {
+    PCI_DEVICE_INFO device;
+    device.Bus = bus;
+    return device;
+}
+
+int main() {
+    Scripted_Backend backend({
+        //   :  0     ,   
+        //        6;    
+        {
+            Status(0x00, 0, 0),
+            Status(0x01, 0, 0),
+            Status(0x01, 0, 0),
+            Status(0x01, 0x10, 0),
+            Status(0x00, 0x10, 0),
+            Status(0x41, 0x10, 0),
+        },
+        //   
+        {
+            Totals(10, 0, 0),
+            Totals(15, 1, 0),
+            Totals(15, 1, 0),
+            Totals(25, 1, 0),
+            Totals(30, 2, 0),
+            Totals(30, 2, 0),
+        },
+        //   AER
+        {},
+    });
+
+    Aer_Sampler sampler(backend, 16);
+    sampler.AddDevice(MakeDevice(0));
+    sampler.AddDevice(MakeDevice(1));
+    sampler.AddDevice(MakeDevice(2));
+
+    std::vector<AER_LATCHED> ticks;
+    for (int i = 0; i < 6; ++i) {
+        sampler.Sample();
+        AER_LATCHED latched{};
+        if (sampler.GetLastLatched(0, latched)) {
+            ticks.push_back(latched);
+        }
+    }
+
+    CHECK(sampler.IsSupported(0));
+    CHECK(sampler.IsStatusOnly(0));
+    CHECK(sampler.IsSupported(1));
+    CHECK(!sampler.IsStatusOnly(1));
+    CHECK(!sampler.IsSupported(2));
+
+    //      
+    AER_RATE rate{};
+    CHECK(!sampler.GetLastRate(0, rate));
+    CHECK(!sampler.GetWindowRate(0, rate));
+
+    //     ,  -   
+    CHECK(ticks.size() == 5);
+    if (ticks.size() == 5) {
+        CHECK(ticks[0].Correctable == 1 && ticks[0].NonFatal == 0);
+        CHECK(ticks[1].Correctable == 0 && ticks[1].NonFatal == 0);
+        CHECK(ticks[2].Correctable == 0 && ticks[2].NonFatal == 1);
+        CHECK(ticks[3].Correctable == 0 && ticks[3].NonFatal == 0);
+        CHECK(ticks[4].Correctable == 2 && ticks[4].NonFatal == 0);
+    }
+
+    AER_LATCHED window{};
+    CHECK(sampler.GetWindowLatched(0, window));
+    CHECK(window.Correctable == 3);
+    CHECK(window.NonFatal == 1);
+    CHECK(window.Fatal == 0);
+
+    //     -      
+    AER_LATCHED none{};
+    CHECK(!sampler.GetLastLatched(1, none));
+    CHECK(!sampler.GetWindowLatched(1, none));
+    CHECK(sampler.GetWindowRate(1, rate));
+    CHECK(rate.Seconds > 0);
+    CHECK(rate.Correctable > 0);
+    CHECK(rate.NonFatal > 0);
+    CHECK(sampler.GetSamples(1).Newest().Counters.Correctable == 30);
+
+    return ReportChecks("aer_sampler");
+}
\ No newline at end of file
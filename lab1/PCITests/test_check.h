@@ -0,0 +1,21 @@
+#pragma once
+#include <cstdio>
+
+inline int g_failures = 0;
+
+#define CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            std::fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition); \
+            ++g_failures; \
+        } \
+    } while (0)
+
+inline int ReportChecks(const char* name) {
+    if (g_failures) {
+        std::fprintf(stderr, "%d check(s) failed\n", g_failures);
+        return 1;
+    }
+    std::printf("%s: OK\n", name);
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "irq_locality.h"
+#include "test_check.h"
+
+static void WriteFile(const std::filesystem::path& path, const std::string& text) {
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream(path, std::ios::trunc) << text;
+}
+
+int main() {
+    std::filesystem::path root = std::filesystem::temp_directory_path() / "test_irq_locality";
+    std::filesystem::remove_all(root);
+
+    //       CPU0  ,    
+    //     CPU4-5  .   43  
+    WriteFile(root / "interrupts",
+        "           CPU0       CPU1       CPU4       CPU5\n"
+        "  11:        100          0          0          0   IO-APIC 11-fasteoi\n"
+        "  40:     900000          0         10          0   PCI-MSI-X nic-0\n"
+        "  41:     800000          0          0          5   PCI-MSI-X nic-1\n"
+        "  42:     700000         20          0          0   PCI-MSI-X nic-2\n"
+        "  50:          0          0       1000          0   PCI-MSI-X nvme-0\n");
+    WriteFile(root / "irq" / "40" / "effective_affinity_list", "4\n");
+    WriteFile(root / "irq" / "41" / "effective_affinity_list", "5\n");
+    WriteFile(root / "irq" / "42" / "effective_affinity_list", "0\n");
+    WriteFile(root / "irq" / "50" / "effective_affinity_list", "1\n");
+
+    std::vector<PCI_DEVICE_INFO> devices(3);
+    devices[0].LocalCpus = "0-1";
+    devices[1].LocalCpus = "0-1";
+    devices[2].LocalCpus = "0-1";
+
+    std::vector<PCI_LOCALITY_ENTRY> entries(3);
+    entries[0].Index = 0;
+    entries[0].Irqs = { 40, 41, 42 };
+    entries[1].Index = 1;
+    entries[1].Irqs = { 50 };
+    entries[2].Index = 2;
+    entries[2].Irqs = { 43 };
+
+    Proc_Interrupts interrupts;
+    CHECK(interrupts.Load((root / "interrupts").string(), { 40, 41, 42, 43, 50 }));
+    CHECK(interrupts.GetAffinity(40) && *interrupts.GetAffinity(40) == "4");
+    CHECK(interrupts.GetAffinity(43) == nullptr);
+    CHECK(interrupts.GetAffinity(11) == nullptr);
+
+    Irq_Locality::Build(devices, interrupts, entries);
+
+    //     ,       
+    const PCI_LOCALITY_ENTRY& nic = entries[0];
+    CHECK(nic.HasAffinity);
+    CHECK(nic.TargetCpus == "0,4-5");
+    CHECK(nic.LocalVectors == 1);
+    CHECK(nic.RemoteVectors == 2);
+    CHECK(nic.HasCounts);
+    CHECK(nic.IrqCpus == "0-1,4-5");
+    CHECK(nic.LocalInterrupts == 2400020);
+    CHECK(nic.RemoteInterrupts == 15);
+
+    //  :      CPU4,      CPU1
+    const PCI_LOCALITY_ENTRY& nvme = entries[1];
+    CHECK(nvme.HasAffinity);
+    CHECK(nvme.TargetCpus == "1");
+    CHECK(nvme.LocalVectors == 1);
+    CHECK(nvme.RemoteVectors == 0);
+    CHECK(nvme.LocalInterrupts == 0);
+    CHECK(nvme.RemoteInterrupts == 1000);
+
+    //  ,    /proc/interrupts
+    const PCI_LOCALITY_ENTRY& unknown = entries[2];
+    CHECK(!unknown.HasAffinity);
+    CHECK(!unknown.HasCounts);
+    CHECK(unknown.LocalVectors + unknown.RemoteVectors == 0);
+
+    std::filesystem::remove_all(root);
+
+    return ReportChecks("irq_locality");
+}
\ No newline at end of file
@@ -0,0 +1,174 @@
+#include <array>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "link_report.h"
+#include "snapshot_backend.h"
+#include "../PCICommon/pci_config.h"
+#include "test_check.h"
+
+using TEST_CONFIG = std::array<uint8_t, PCI_CFG_SPACE_SIZE>;
+
+//  :     ,  
+class Fixed_Backend : public PCI_Backend {
+private:
+    std::vector<PCI_DEVICE_INFO> m_devices;
+    std::map<uint32_t, TEST_CONFIG> m_configs;
+
+public:
+    bool Open() override { return true; }
+    void Close() override {}
+    bool IsOpen() const override { return true; }
+    void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) override { devices = m_devices; }
+    const char* GetName() const override { return "fixed"; }
+
+    bool ReadConfigSpace(const PCI_DEVICE_INFO& device, std::vector<uint8_t>& config) override {
+        auto it = m_configs.find(device.GetKey());
+        if (it == m_configs.end()) {
+            return false;
+        }
+        config.assign(it->second.begin(), it->second.end());
+        return true;
+    }
+
+    //    PCI Express capability;   secondary  subordinate
+    //    
+    void Add(uint16_t segment, uint8_t bus, uint8_t device, uint8_t function, uint8_t portType,
+        uint32_t linkCaps, uint16_t linkStatus, uint8_t secondary = 0, uint8_t subordinate = 0) {
+        PCI_DEVICE_INFO info{};
+        info.Segment = segment;
+        info.Bus = bus;
+        info.Device = device;
+        info.Function = function;
+        info.HeaderType = secondary ? PCI_HEADER_TYPE_BRIDGE : PCI_HEADER_TYPE_NORMAL;
+        info.VendorID = 0x8086;
+        info.DeviceID = secondary ? 0x3C00 : 0x1500;
+        info.BaseClass = secondary ? 0x06 : 0x02;
+        info.SubClass = secondary ? 0x04 : 0x00;
+        info.SecondaryBus = secondary;
+        info.SubordinateBus = subordinate;
+
+        TEST_CONFIG& config = m_configs[info.GetKey()];
+        config.fill(0);
+        Put32(config, PCI_CFG_ID, (static_cast<uint32_t>(info.DeviceID) << 16) | info.VendorID);
+        Put16(config, PCI_CFG_STATUS, PCI_STATUS_CAP_LIST);
+        Put32(config, PCI_CFG_CLASS_REV, static_cast<uint32_t>(info.BaseClass) << 24 | info.SubClass << 16);
+        config[PCI_CFG_HEADER + 2] = info.HeaderType;
+        if (secondary) {
+            Put32(config, PCI_CFG_BUS_NUMBERS, bus | (secondary << 8) | (subordinate << 16));
+        }
+        config[PCI_CFG_CAP_PTR] = 0x40;
+        Put16(config, 0x40, PCI_CAP_ID_EXP);
+        Put16(config, 0x40 + PCI_EXP_FLAGS, static_cast<uint16_t>(0x0002 | (portType << 4)));
+        Put32(config, 0x40 + PCI_EXP_LNKCAP, linkCaps);
+        Put16(config, 0x40 + PCI_EXP_LNKSTA, linkStatus);
+        m_devices.push_back(info);
+    }
+
+private:
+    static void Put16(TEST_CONFIG& config, uint16_t offset, uint16_t value) {
+        config[offset] = static_cast<uint8_t>(value);
+        config[offset + 1] = static_cast<uint8_t>(value >> 8);
+    }
+
+    static void Put32(TEST_CONFIG& config, uint16_t offset, uint32_t value) {
+        Put16(config, offset, static_cast<uint16_t>(value));
+        Put16(config, offset + 2, static_cast<uint16_t>(value >> 16));
+    }
+};
+
+static uint32_t IndexOf(const std::vector<PCI_DEVICE_INFO>& devices, uint16_t segment, uint8_t bus, uint8_t device, uint8_t function) {
+    for (uint32_t i = 0; i < devices.size(); ++i) {
+        if (devices[i].Segment == segment && devices[i].Bus == bus && devices[i].Device == device && devices[i].Function == function) {
+            return i;
+        }
+    }
+    return PCI_Topology::None;
+}
+
+int main() {
+    constexpr uint32_t Gen4x8 = 0x84;
+    constexpr uint32_t Gen3x8 = 0x83;
+    Fixed_Backend source;
+
+    //  0:   ->  ->    x8 Gen3.
+    //         x1 -     x1 Gen4
+    source.Add(0, 0, 1, 0, PCI_EXP_TYPE_ROOT_PORT, Gen4x8, 0x14, 1, 3);
+    source.Add(0, 1, 0, 0, PCI_EXP_TYPE_UPSTREAM, Gen4x8, 0x14, 2, 3);
+    source.Add(0, 2, 0, 0, PCI_EXP_TYPE_DOWNSTREAM, Gen4x8, Gen3x8, 3, 3);
+    source.Add(0, 3, 0, 0, PCI_EXP_TYPE_ENDPOINT, Gen3x8, Gen3x8);
+    source.Add(0, 3, 0, 1, PCI_EXP_TYPE_ENDPOINT, Gen3x8, Gen3x8);
+
+    //  1:           - 
+    //   -,        
+    source.Add(1, 0, 1, 0, PCI_EXP_TYPE_ROOT_PORT, Gen4x8, 0x24, 1, 2);
+    source.Add(1, 1, 0, 0, PCI_EXP_TYPE_DOWNSTREAM, Gen4x8, Gen4x8, 2, 2);
+    source.Add(1, 1, 1, 0, PCI_EXP_TYPE_ENDPOINT, Gen3x8, Gen3x8);
+
+    std::string path = (std::filesystem::temp_directory_path() / "test_link_report.snap").string();
+    Snapshot_Backend::Record(source, path);
+
+    Snapshot_Backend snapshot(path);
+    CHECK(snapshot.Open());
+    snapshot.SetConfigCapture(true);
+    std::vector<PCI_DEVICE_INFO> devices;
+    snapshot.Enumerate(devices);
+    CHECK(devices.size() == 8);
+
+    PCI_Topology topology;
+    topology.Build(devices);
+    PCI_Link_Report report;
+    report.Build(devices, topology);
+
+    uint32_t rootPort = IndexOf(devices, 0, 0, 1, 0);
+    uint32_t upstream = IndexOf(devices, 0, 1, 0, 0);
+    uint32_t downstream = IndexOf(devices, 0, 2, 0, 0);
+    uint32_t nic = IndexOf(devices, 0, 3, 0, 0);
+    uint32_t nicSecond = IndexOf(devices, 0, 3, 0, 1);
+    uint32_t sharedRoot = IndexOf(devices, 1, 0, 1, 0);
+    uint32_t sharedPort = IndexOf(devices, 1, 1, 0, 0);
+    uint32_t sharedDevice = IndexOf(devices, 1, 1, 1, 0);
+    CHECK(nicSecond != PCI_Topology::None && sharedDevice != PCI_Topology::None);
+    if (nicSecond == PCI_Topology::None || sharedDevice == PCI_Topology::None) {
+        return ReportChecks("link_report");
+    }
+
+    //   0    ,     .
+    //   1  x2      x8 Gen4
+    CHECK(report.GetDegradedCount() == 3);
+    CHECK(report.GetLink(rootPort).Degraded);
+    CHECK(report.GetLink(upstream).Degraded);
+    CHECK(!report.GetLink(downstream).Degraded);
+    CHECK(!report.GetLink(nic).Degraded);
+    CHECK(!report.GetLink(nicSecond).Degraded);
+    CHECK(report.GetLink(sharedRoot).Degraded);
+    CHECK(!report.GetLink(sharedDevice).Degraded);
+
+    //   -   : Gen4  , Gen3    
+    CHECK(report.GetLink(rootPort).CapableSpeed == 4 && report.GetLink(rootPort).CapableWidth == 8);
+    CHECK(report.GetLink(downstream).CapableSpeed == 3 && report.GetLink(downstream).CapableWidth == 8);
+    CHECK(report.GetLink(nicSecond).CapableSpeed == 3);
+
+    //   -        
+    CHECK(report.GetLink(sharedRoot).CapableSpeed == 4 && report.GetLink(sharedRoot).CapableWidth == 8);
+    CHECK(report.GetLink(sharedPort).CapableSpeed == 4);
+    CHECK(report.GetLink(sharedDevice).CapableSpeed == 3);
+
+    //        -    
+    size_t limited = 0;
+    for (const PCI_LINK_PATH& linkPath : report.GetPaths()) {
+        if (linkPath.Index == nic || linkPath.Index == nicSecond) {
+            CHECK(linkPath.Bottleneck == upstream);
+            CHECK(linkPath.AvailableBandwidth == PCI_Link_Report::GetBandwidth(4, 1));
+            CHECK(linkPath.CapableBandwidth == PCI_Link_Report::GetBandwidth(3, 8));
+            limited++;
+        }
+    }
+    CHECK(limited == 2);
+
+    snapshot.Close();
+    std::filesystem::remove(path);
+
+    return ReportChecks("link_report");
+}
\ No newline at end of file
@@ -0,0 +1,58 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include "pci_ids_db.h"
+#include "test_check.h"
+
+static bool NameIs(const char* name, const char* expected) {
+    return name && std::strcmp(name, expected) == 0;
+}
+
+int main() {
+    std::filesystem::path dir = std::filesystem::temp_directory_path();
+    std::string idsPath = (dir / "test_pci_ids_db.ids").string();
+    std::string dbPath = (dir / "test_pci_ids_db.bin").string();
+
+    //  1000:0000   1000:0000  ,    
+    //      -       
+    {
+        std::ofstream ids(idsPath, std::ios::trunc);
+        ids << "# test\n"
+            << "1000  Broadcom / LSI\n"
+            << "\t0000  Dev Zero\n"
+            << "\t\t1000 0000  Sub Zero\n"
+            << "\t\t1000 0001  Sub One\n"
+            << "\t0001  Dev One\n"
+            << "8086  Intel Corporation\n"
+            << "\t1000  82542 Gigabit Ethernet Controller\n"
+            << "C 02  Network controller\n"
+            << "\t00  Ethernet controller\n";
+    }
+
+    std::string err;
+    CHECK(PCI_Ids_Database::Compile(idsPath, dbPath, err));
+    CHECK(err.empty());
+
+    PCI_Ids_Database db;
+    CHECK(db.Open(dbPath));
+    CHECK(db.GetEntryCount() == 9);
+    CHECK(NameIs(db.FindVendor(0x1000), "Broadcom / LSI"));
+    CHECK(NameIs(db.FindDevice(0x1000, 0x0000), "Dev Zero"));
+    CHECK(NameIs(db.FindDevice(0x1000, 0x0001), "Dev One"));
+    CHECK(NameIs(db.FindSubsystem(0x1000, 0x0000, 0x1000, 0x0000), "Sub Zero"));
+    CHECK(NameIs(db.FindSubsystem(0x1000, 0x0000, 0x1000, 0x0001), "Sub One"));
+    CHECK(NameIs(db.FindVendor(0x8086), "Intel Corporation"));
+    CHECK(NameIs(db.FindDevice(0x8086, 0x1000), "82542 Gigabit Ethernet Controller"));
+    CHECK(NameIs(db.FindClass(0x02), "Network controller"));
+    CHECK(NameIs(db.FindSubClass(0x02, 0x00), "Ethernet controller"));
+    CHECK(db.FindDevice(0x1000, 0x0002) == nullptr);
+    CHECK(db.FindSubsystem(0x1000, 0x0001, 0x1000, 0x0000) == nullptr);
+    CHECK(db.FindVendor(0x10DE) == nullptr);
+    db.Close();
+
+    std::filesystem::remove(idsPath);
+    std::filesystem::remove(dbPath);
+
+    return ReportChecks("pci_ids_db");
+}
\ No newline at end of file
@@ -0,0 +1,235 @@
+#include <cstring>
+#include <thread>
+#include <tuple>
+#include <vector>
+#include "ring_backend.h"
+#include "synthetic_topology.h"
+#include "test_check.h"
+
+using TEST_BDF = std::tuple<uint8_t, uint8_t, uint8_t>;
+
+//    n:      n, 
+//    n + 
+static void FillRecord(PCI_RING* ring, PCI_WIRE_RECORD* record, uint32_t n) {
+    PCI_WALK_FUNCTION function{};
+    function.Bus = static_cast<uint8_t>(n >> 8);
+    function.Device = static_cast<uint8_t>((n >> 3) & 0x1F);
+    function.Function = static_cast<uint8_t>(n & 7);
+    function.IdDword = n * 0x10001u;
+    PciWireFillRecord(record, &function);
+
+    uint8_t* config = PciRingRecordConfig(ring, record);
+    for (uint16_t i = 0; i < ring->ConfigSize; ++i) {
+        config[i] = static_cast<uint8_t>(n + i);
+    }
+}
+
+static bool RecordIs(PCI_RING* ring, const PCI_WIRE_RECORD* record, uint32_t n) {
+    if (!record || record->Bus != static_cast<uint8_t>(n >> 8) || record->Device != ((n >> 3) & 0x1F) ||
+        record->Function != (n & 7) || record->VendorID != static_cast<uint16_t>(n)) {
+        return false;
+    }
+    const uint8_t* config = PciRingRecordConfig(ring, record);
+    for (uint16_t i = 0; i < ring->ConfigSize; ++i) {
+        if (config[i] != static_cast<uint8_t>(n + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+//      ,  config   ;
+//        
+static void TestLayout() {
+    std::vector<uint8_t> memory(PciRingSize(4, 8));
+    PCI_RING producer{}, consumer{};
+
+    CHECK(PciRingSize(4, 8) == sizeof(PCI_RING_HEADER) + 4 * (sizeof(PCI_WIRE_RECORD) + 8));
+    CHECK(!PciRingInit(&producer, memory.data(), static_cast<uint32_t>(memory.size()), 3, 8));
+    CHECK(!PciRingInit(&producer, memory.data(), static_cast<uint32_t>(memory.size()), 4, 6));
+    CHECK(!PciRingInit(&producer, memory.data(), static_cast<uint32_t>(memory.size()) - 1, 4, 8));
+    CHECK(PciRingInit(&producer, memory.data(), static_cast<uint32_t>(memory.size()), 4, 8));
+    CHECK(PciRingAttach(&consumer, memory.data(), static_cast<uint32_t>(memory.size())));
+    CHECK(consumer.Capacity == 4 && consumer.ConfigSize == 8 && consumer.RecordSize == producer.RecordSize);
+    CHECK(!PciRingAttach(&consumer, memory.data(), static_cast<uint32_t>(memory.size()) - 1));
+
+    producer.Header->Capacity = 8;
+    CHECK(!PciRingAttach(&consumer, memory.data(), static_cast<uint32_t>(memory.size())));
+    producer.Header->Capacity = 4;
+    producer.Header->Magic ^= 1;
+    CHECK(!PciRingAttach(&consumer, memory.data(), static_cast<uint32_t>(memory.size())));
+}
+
+//       :     , 
+//  ,    ,       
+static void TestWraparound() {
+    constexpr uint32_t Capacity = 4;
+    std::vector<uint8_t> memory(PciRingSize(Capacity, 8));
+    PCI_RING producer{}, consumer{};
+    CHECK(PciRingInit(&producer, memory.data(), static_cast<uint32_t>(memory.size()), Capacity, 8));
+    CHECK(PciRingAttach(&consumer, memory.data(), static_cast<uint32_t>(memory.size())));
+    PciRingReset(&consumer);
+    PciRingBegin(&producer);
+
+    CHECK(PciRingPeek(&consumer) == nullptr);
+    CHECK(PciRingPoll(&consumer) == PCI_RING_RUNNING);
+
+    uint32_t produced = 0, consumed = 0;
+    for (; produced < Capacity; ++produced) {
+        PCI_WIRE_RECORD* record = PciRingReserve(&producer);
+        CHECK(record != nullptr);
+        if (!record) {
+            return;
+        }
+        FillRecord(&producer, record, produced);
+        PciRingCommit(&producer);
+    }
+    CHECK(PciRingReserve(&producer) == nullptr);
+
+    //    :    -     
+    for (uint32_t round = 0; round < 3 * Capacity; ++round) {
+        for (int i = 0; i < 2; ++i, ++consumed) {
+            CHECK(RecordIs(&consumer, PciRingPeek(&consumer), consumed));
+            PciRingRelease(&consumer);
+        }
+        for (int i = 0; i < 2; ++i, ++produced) {
+            PCI_WIRE_RECORD* record = PciRingReserve(&producer);
+            CHECK(record != nullptr);
+            if (!record) {
+                return;
+            }
+            FillRecord(&producer, record, produced);
+            PciRingCommit(&producer);
+        }
+        CHECK(PciRingReserve(&producer) == nullptr);
+    }
+
+    //      ,    
+    PciRingFinish(&producer, PCI_RING_DONE);
+    CHECK(producer.Header->TotalCount == produced);
+    while (consumed < produced) {
+        CHECK(PciRingPoll(&consumer) == PCI_RING_RUNNING);
+        CHECK(RecordIs(&consumer, PciRingPeek(&consumer), consumed));
+        PciRingRelease(&consumer);
+        ++consumed;
+    }
+    CHECK(PciRingPeek(&consumer) == nullptr);
+    CHECK(PciRingPoll(&consumer) == PCI_RING_DONE);
+}
+
+//       :     
+//   ,  -  
+static void TestShortCapacity() {
+    constexpr uint32_t Capacity = 2;
+    constexpr uint32_t Records = 20000;
+    std::vector<uint8_t> memory(PciRingSize(Capacity, PCI_CFG_HEADER_SIZE));
+    PCI_RING producer{}, consumer{};
+    CHECK(PciRingInit(&producer, memory.data(), static_cast<uint32_t>(memory.size()), Capacity, PCI_CFG_HEADER_SIZE));
+    CHECK(PciRingAttach(&consumer, memory.data(), static_cast<uint32_t>(memory.size())));
+    PciRingReset(&consumer);
+
+    std::thread thread([&] {
+        PciRingBegin(&producer);
+        for (uint32_t n = 0; n < Records; ++n) {
+            PCI_WIRE_RECORD* record;
+            while ((record = PciRingReserve(&producer)) == nullptr) {
+                std::this_thread::yield();
+            }
+            FillRecord(&producer, record, n);
+            PciRingCommit(&producer);
+        }
+        PciRingFinish(&producer, PCI_RING_DONE);
+    });
+
+    uint32_t consumed = 0, broken = 0, state;
+    while ((state = PciRingPoll(&consumer)) == PCI_RING_RUNNING) {
+        const PCI_WIRE_RECORD* record = PciRingPeek(&consumer);
+        if (!record) {
+            std::this_thread::yield();
+            continue;
+        }
+        broken += !RecordIs(&consumer, record, consumed);
+        PciRingRelease(&consumer);
+        ++consumed;
+    }
+    thread.join();
+
+    CHECK(state == PCI_RING_DONE);
+    CHECK(consumed == Records);
+    CHECK(broken == 0);
+    CHECK(consumer.Header->TotalCount == Records);
+}
+
+// ,       
+static std::vector<TEST_BDF> WalkOrder(const Synthetic_Topology& topology) {
+    struct CONTEXT {
+        const Synthetic_Topology* Topology;
+        std::vector<TEST_BDF> Order;
+    } context{ &topology, {} };
+
+    PCI_WALK_OPS ops{};
+    ops.Context = &context;
+    ops.ConfigSize = PCI_CFG_EXT_SPACE_SIZE;
+    ops.ReadConfig = [](void* context, uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
+        return static_cast<CONTEXT*>(context)->Topology->Read(bus, device, function, offset);
+    };
+    ops.Visit = [](void* context, const PCI_WALK_FUNCTION* function) {
+        static_cast<CONTEXT*>(context)->Order.push_back({ function->Bus, function->Device, function->Function });
+        return 1;
+    };
+    PCI_WALK_STATS stats{};
+    CHECK(PciWalkTopology(&ops, &stats) == PCI_WALK_COMPLETED);
+    return context.Order;
+}
+
+//    :        
+// ,         
+static void TestBackend() {
+    SYNTHETIC_TOPOLOGY_PARAMS params;
+    params.Depth = 2;
+    params.FanOut = 4;
+    params.Endpoints = 4;
+    params.VirtualFunctions = 32;
+    Synthetic_Topology topology(params);
+    std::vector<TEST_BDF> expected = WalkOrder(topology);
+    //   -  1024 ,      
+    CHECK(expected.size() > 3 * 1024);
+
+    Synthetic_Ring_Backend backend(params);
+    CHECK(backend.Open());
+    backend.SetConfigCapture(true);
+
+    std::vector<PCI_DEVICE_INFO> devices;
+    backend.Enumerate(devices);
+    CHECK(devices.size() == expected.size());
+
+    size_t broken = 0;
+    for (size_t i = 0; i < devices.size() && i < expected.size(); ++i) {
+        const PCI_DEVICE_INFO& device = devices[i];
+        uint16_t size = 0;
+        const uint8_t* config = topology.GetConfig(device.Bus, device.Device, device.Function, size);
+        bool intact = TEST_BDF{ device.Bus, device.Device, device.Function } == expected[i] &&
+            config && device.Config && device.ConfigSize == PCI_CFG_SPACE_SIZE &&
+            std::memcmp(device.Config, config, PCI_CFG_SPACE_SIZE) == 0;
+        broken += !intact;
+    }
+    CHECK(broken == 0);
+
+    //        ;   
+    size_t batches = 0;
+    CHECK(!backend.EnumerateBatches([&](std::vector<PCI_DEVICE_INFO>&) { return ++batches < 1; }));
+    CHECK(batches == 1);
+    backend.Enumerate(devices);
+    CHECK(devices.size() == expected.size());
+
+    backend.Close();
+}
+
+int main() {
+    TestLayout();
+    TestWraparound();
+    TestShortCapacity();
+    TestBackend();
+
+    return ReportChecks("pci_ring");
+}
\ No newline at end of file
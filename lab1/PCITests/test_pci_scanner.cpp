@@ -0,0 +1,75 @@
+#include <memory>
+#include <vector>
+#include "pci_scanner.h"
+#include "test_check.h"
+
+//     ,    ,  
+class Fixed_Backend : public PCI_Backend {
+private:
+    std::vector<PCI_DEVICE_INFO> m_devices;
+    bool m_open{ false };
+
+public:
+    explicit Fixed_Backend(std::vector<PCI_DEVICE_INFO> devices)
+        : m_devices(std::move(devices)) {
+    }
+
+    bool Open() override { m_open = true; return true; }
+    void Close() override { m_open = false; }
+    bool IsOpen() const override { return m_open; }
+    const char* GetName() const override { return "fixed"; }
+
+    void Enumerate(std::vector<PCI_DEVICE_INFO>& devices) override {
+        devices.clear();
+        for (const auto& device : m_devices) {
+            if (Matches(device)) {
+                devices.push_back(device);
+            }
+        }
+    }
+};
+
+static PCI_DEVICE_INFO MakeDevice(uint8_t bus, uint16_t vendorId, uint16_t deviceId, uint8_t baseClass) {
+    PCI_DEVICE_INFO device;
+    device.Bus = bus;
+    device.VendorID = vendorId;
+    device.DeviceID = deviceId;
+    device.BaseClass = baseClass;
+    return device;
+}
+
+int main() {
+    std::vector<PCI_DEVICE_INFO> devices = {
+        MakeDevice(0, 0x8086, 0x0D57, 0x06),
+        MakeDevice(1, 0x8086, 0x159B, 0x02),
+        MakeDevice(2, 0x10DE, 0x2330, 0x03),
+    };
+
+    PCI_Scanner_App scanner(std::make_unique<Fixed_Backend>(devices));
+    CHECK(scanner.Initialize());
+
+    PCI_FILTER network{};
+    network.Flags = PCI_FILTER_CLASS;
+    network.ClassCode = 0x0200;
+    network.ClassMask = 0xFF00;
+
+    auto filtered = scanner.Scan(network);
+    CHECK(filtered.size() == 1);
+    CHECK(!filtered.empty() && filtered[0].Bus == 1);
+
+    //      :   
+    PCI_SCAN_DELTA delta = scanner.ScanDelta();
+    CHECK(delta.IsEmpty());
+
+    // Scan()       
+    auto all = scanner.Scan();
+    CHECK(all.size() == devices.size());
+
+    //         
+    delta = scanner.ScanDelta();
+    CHECK(delta.IsEmpty());
+
+    scanner.Shutdown();
+
+    return ReportChecks("pci_scanner");
+}
\ No newline at end of file
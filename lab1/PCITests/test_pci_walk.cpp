@@ -0,0 +1,137 @@
+#include <map>
+#include <set>
+#include <tuple>
+#include <vector>
+#include "pci_walk.h"
+#include "test_check.h"
+
+//   ,  :   64 ,
+//     0xFFFFFFFF
+struct TEST_IMAGE {
+    std::map<std::tuple<uint8_t, uint8_t, uint8_t>, std::vector<uint32_t>> Functions;
+    std::map<uint8_t, unsigned> Reads;
+    std::map<uint8_t, unsigned> SlotZeroProbes;
+    unsigned TotalReads{ 0 };
+    std::vector<std::tuple<uint8_t, uint8_t, uint8_t>> Visited;
+
+    void AddNormal(uint8_t bus, uint8_t device, uint8_t function, bool multifunction) {
+        std::vector<uint32_t> header(PCI_CFG_HEADER_DWORDS, 0);
+        header[PCI_CFG_ID / 4] = 0x12348086u + function;
+        header[PCI_CFG_CLASS_REV / 4] = 0x02000001u;
+        header[PCI_CFG_HEADER / 4] = static_cast<uint32_t>(PCI_HEADER_TYPE_NORMAL | (multifunction ? PCI_HEADER_MULTIFUNCTION : 0)) << 16;
+        Functions[{ bus, device, function }] = header;
+    }
+
+    void AddBridge(uint8_t bus, uint8_t device, uint8_t secondary, uint8_t subordinate) {
+        std::vector<uint32_t> header(PCI_CFG_HEADER_DWORDS, 0);
+        header[PCI_CFG_ID / 4] = 0x43218086u;
+        header[PCI_CFG_CLASS_REV / 4] = 0x06040000u;
+        header[PCI_CFG_HEADER / 4] = static_cast<uint32_t>(PCI_HEADER_TYPE_BRIDGE) << 16;
+        header[PCI_CFG_BUS_NUMBERS / 4] = bus | (secondary << 8) | (subordinate << 16);
+        Functions[{ bus, device, 0 }] = header;
+    }
+};
+
+static uint32_t ReadConfig(void* context, uint8_t bus, uint8_t device, uint8_t function, uint16_t offset) {
+    TEST_IMAGE* image = static_cast<TEST_IMAGE*>(context);
+    ++image->TotalReads;
+    ++image->Reads[bus];
+    if (device == 0 && function == 0 && offset == PCI_CFG_ID) {
+        ++image->SlotZeroProbes[bus];
+    }
+
+    auto it = image->Functions.find({ bus, device, function });
+    if (it == image->Functions.end() || offset >= PCI_CFG_HEADER_SIZE) {
+        return 0xFFFFFFFFu;
+    }
+    return it->second[offset / 4];
+}
+
+static int Visit(void* context, const PCI_WALK_FUNCTION* function) {
+    TEST_IMAGE* image = static_cast<TEST_IMAGE*>(context);
+    image->Visited.push_back({ function->Bus, function->Device, function->Function });
+    return 1;
+}
+
+int main() {
+    TEST_IMAGE image;
+
+    //  0: 00.0 -  ,      00.1;
+    // 01.0 -    1-2; 02.x -       02.1;
+    //  03.x   0; 04.0 - ,     1
+    image.AddNormal(0, 0, 0, false);
+    image.AddNormal(0, 0, 1, false);
+    image.AddBridge(0, 1, 1, 2);
+    image.AddNormal(0, 2, 0, true);
+    image.AddNormal(0, 2, 2, true);
+    image.AddNormal(0, 3, 1, false);
+    image.AddBridge(0, 4, 1, 1);
+
+    //  1: 00.0 -    2; 01.0 -       0
+    image.AddBridge(1, 0, 2, 2);
+    image.AddBridge(1, 1, 0, 5);
+
+    //  2:    ,       
+    image.AddNormal(2, 0, 0, false);
+    image.AddBridge(2, 5, 2, 2);
+
+    PCI_WALK_OPS ops = {};
+    ops.ReadConfig = ReadConfig;
+    ops.Visit = Visit;
+    ops.Context = &image;
+
+    PCI_WALK_STATS stats = {};
+    CHECK(PciWalkTopology(&ops, &stats) == PCI_WALK_COMPLETED);
+
+    //  -   :     ,   
+    std::vector<std::tuple<uint8_t, uint8_t, uint8_t>> expected = {
+        { 0, 0, 0 }, { 0, 1, 0 }, { 1, 0, 0 }, { 2, 0, 0 }, { 2, 5, 0 },
+        { 1, 1, 0 }, { 0, 2, 0 }, { 0, 2, 2 }, { 0, 4, 0 },
+    };
+    CHECK(image.Visited == expected);
+    CHECK(stats.FunctionsFound == expected.size());
+    CHECK(stats.VirtualFunctions == 0);
+
+    //  1-7      00.0,     03
+    std::set<std::tuple<uint8_t, uint8_t, uint8_t>> visited(image.Visited.begin(), image.Visited.end());
+    CHECK(!visited.count({ 0, 0, 1 }));
+    CHECK(!visited.count({ 0, 3, 1 }));
+
+    //      ,      
+    CHECK(stats.BusesScanned == 3);
+    CHECK(image.SlotZeroProbes.size() == 3);
+    for (const auto& [bus, probes] : image.SlotZeroProbes) {
+        CHECK(bus <= 2);
+        CHECK(probes == 1);
+    }
+
+    //   -   Vendor ID;   -    ;
+    //  -  ,      -      PCI Express capability
+    //  0: 4 + 6 + (4 + 1 + 4 + 5) + 1 + 6 + 27 = 58
+    //  1: 6 + 4 + 30 = 40
+    //  2: 4 + 4 + 30 = 38
+    CHECK(image.Reads[0] == 58);
+    CHECK(image.Reads[1] == 40);
+    CHECK(image.Reads[2] == 38);
+    CHECK(stats.ConfigReads == 136);
+    CHECK(stats.ConfigReads == image.TotalReads);
+
+    //    ,  ,    
+    TEST_IMAGE again = image;
+    again.Reads.clear();
+    again.SlotZeroProbes.clear();
+    again.TotalReads = 0;
+    again.Visited.clear();
+    uint8_t root = 0;
+    ops.Context = &again;
+    ops.RootBuses = &root;
+    ops.RootBusCount = 1;
+    PCI_WALK_STATS repeat = {};
+    CHECK(PciWalkTopology(&ops, &repeat) == PCI_WALK_COMPLETED);
+    CHECK(again.Visited == expected);
+    CHECK(repeat.ConfigReads == stats.ConfigReads);
+
+    CHECK(PciWalkTopology(nullptr, &stats) == PCI_WALK_INVALID_ARGS);
+
+    return ReportChecks("pci_walk");
+}
\ No newline at end of file
@@ -0,0 +1,198 @@
+#include <cstring>
+#include <vector>
+#include "pci_wire.h"
+#include "pci_decoder.h"
+#include "test_check.h"
+
+// ,     : ,     VF
+static std::vector<PCI_WALK_FUNCTION> MakeFunctions() {
+    std::vector<PCI_WALK_FUNCTION> functions(3);
+
+    functions[0].Bus = 0;
+    functions[0].Device = 1;
+    functions[0].HeaderType = PCI_HEADER_TYPE_BRIDGE | PCI_HEADER_MULTIFUNCTION;
+    functions[0].IdDword = 0x1A2B8086u;
+    functions[0].ClassDword = 0x06040011u;
+    functions[0].SecondaryBus = 3;
+    functions[0].SubordinateBus = 4;
+
+    functions[1].Bus = 3;
+    functions[1].HeaderType = PCI_HEADER_TYPE_NORMAL;
+    functions[1].IdDword = 0x159B8086u;
+    functions[1].ClassDword = 0x02000002u;
+    functions[1].SubsystemDword = 0x00018086u;
+
+    functions[2].Bus = 3;
+    functions[2].Device = 2;
+    functions[2].Function = 5;
+    functions[2].HeaderType = PCI_HEADER_TYPE_NORMAL;
+    functions[2].IdDword = 0x18898086u;
+    functions[2].ClassDword = 0x02000002u;
+    functions[2].SubsystemDword = 0x00018086u;
+    functions[2].Virtual = 1;
+    functions[2].PhysicalFunction = 0x0300;
+    return functions;
+}
+
+//    ,    
+static void FillConfig(uint8_t* config, uint16_t configSize, const PCI_WALK_FUNCTION& function) {
+    auto put = [&](uint16_t offset, uint32_t value) {
+        for (int i = 0; i < 4; ++i) {
+            config[offset + i] = static_cast<uint8_t>(value >> (i * 8));
+        }
+    };
+
+    std::memset(config, 0, configSize);
+    put(PCI_CFG_ID, function.Virtual ? 0xFFFFFFFFu : function.IdDword);
+    put(PCI_CFG_CLASS_REV, function.ClassDword);
+    put(PCI_CFG_HEADER, static_cast<uint32_t>(function.HeaderType) << 16);
+    if ((function.HeaderType & PCI_HEADER_TYPE_MASK) == PCI_HEADER_TYPE_BRIDGE) {
+        put(PCI_CFG_BUS_NUMBERS, function.Bus | (function.SecondaryBus << 8) | (function.SubordinateBus << 16));
+    }
+    else {
+        put(PCI_CFG_SUBSYSTEM, function.SubsystemDword);
+    }
+    config[configSize - 1] = static_cast<uint8_t>(function.Bus ^ function.Device ^ function.Function ^ 0x5A);
+}
+
+//  :  ,  ; config   
+static std::vector<uint8_t> Encode(const std::vector<PCI_WALK_FUNCTION>& functions, uint16_t configSize, uint32_t bufferSize) {
+    std::vector<uint8_t> buffer(bufferSize);
+    PciWireBegin(buffer.data(), configSize);
+
+    for (const PCI_WALK_FUNCTION& function : functions) {
+        PCI_WIRE_RECORD record;
+        PciWireFillRecord(&record, &function);
+        uint8_t* config = PciWireAppend(buffer.data(), bufferSize, &record);
+        if (config && configSize) {
+            FillConfig(config, configSize, function);
+        }
+    }
+    return buffer;
+}
+
+static void CheckDevice(const PCI_DEVICE_INFO& device, const PCI_WALK_FUNCTION& function) {
+    CHECK(device.Bus == function.Bus);
+    CHECK(device.Device == function.Device);
+    CHECK(device.Function == function.Function);
+    CHECK(device.HeaderType == function.HeaderType);
+    CHECK(device.VendorID == PCI_ID_VENDOR(function.IdDword));
+    CHECK(device.DeviceID == PCI_ID_DEVICE(function.IdDword));
+    CHECK(device.BaseClass == PCI_CLASS_BASE(function.ClassDword));
+    CHECK(device.SubClass == PCI_CLASS_SUB(function.ClassDword));
+    CHECK(device.ProgIF == PCI_CLASS_PROG_IF(function.ClassDword));
+    CHECK(device.Revision == PCI_CLASS_REVISION(function.ClassDword));
+    CHECK(device.SubsystemVendorID == PCI_ID_VENDOR(function.SubsystemDword));
+    CHECK(device.SubsystemID == PCI_ID_DEVICE(function.SubsystemDword));
+    CHECK(device.Virtual == (function.Virtual != 0));
+    CHECK(device.PhysicalFunction == (function.Virtual ? function.PhysicalFunction : 0));
+}
+
+// ,     ,    Driver_Backend
+static void TestRoundTrip(uint16_t configSize) {
+    std::vector<PCI_WALK_FUNCTION> functions = MakeFunctions();
+    uint32_t size = PciWireBufferSize(static_cast<uint32_t>(functions.size()), configSize);
+    std::vector<uint8_t> buffer = Encode(functions, configSize, size);
+    const PCI_WIRE_HEADER* header = reinterpret_cast<const PCI_WIRE_HEADER*>(buffer.data());
+
+    CHECK(PciWireUsedSize(buffer.data()) == size);
+    CHECK(PciWireValidate(buffer.data(), size) == PCI_WIRE_OK);
+    CHECK(header->RecordCount == functions.size());
+    CHECK(header->TotalCount == functions.size());
+    CHECK(header->RecordSize == sizeof(PCI_WIRE_RECORD) + configSize);
+    CHECK(header->ConfigSize == configSize);
+    CHECK(header->Flags == (configSize ? PCI_WIRE_FLAG_CONFIG : 0));
+
+    for (uint32_t i = 0; i < header->RecordCount; ++i) {
+        PCI_DEVICE_INFO device;
+        PCI_Config_Decoder::DecodeWireRecord(*PciWireRecordAt(buffer.data(), i), device);
+        if (header->ConfigSize) {
+            const uint8_t* config = PciWireRecordConfig(buffer.data(), i);
+            CHECK(config == reinterpret_cast<const uint8_t*>(PciWireRecordAt(buffer.data(), i)) + sizeof(PCI_WIRE_RECORD));
+            CHECK(config[configSize - 1] == (functions[i].Bus ^ functions[i].Device ^ functions[i].Function ^ 0x5A));
+
+            //  VF     -    
+            if (!functions[i].Virtual) {
+                CHECK(PCI_Config_Decoder::DecodeHeader(config, configSize, device));
+                CHECK(device.SecondaryBus == functions[i].SecondaryBus);
+                CHECK(device.SubordinateBus == functions[i].SubordinateBus);
+            }
+        }
+        CheckDevice(device, functions[i]);
+    }
+}
+
+// ,    ,   ,     
+static void TestBufferSize() {
+    CHECK(sizeof(PCI_WIRE_HEADER) == 24);
+    CHECK(sizeof(PCI_WIRE_RECORD) == 20);
+    CHECK(PciWireBufferSize(0, 0) == sizeof(PCI_WIRE_HEADER));
+    CHECK(PciWireBufferSize(3, 0) == 24 + 3 * 20);
+    CHECK(PciWireBufferSize(3, PCI_CFG_SPACE_SIZE) == 24 + 3 * (20 + 256));
+
+    //  :    , TotalCount     
+    std::vector<PCI_WALK_FUNCTION> functions = MakeFunctions();
+    std::vector<uint8_t> probe = Encode(functions, PCI_CFG_SPACE_SIZE, sizeof(PCI_WIRE_HEADER));
+    const PCI_WIRE_HEADER* header = reinterpret_cast<const PCI_WIRE_HEADER*>(probe.data());
+    CHECK(header->RecordCount == 0);
+    CHECK(header->TotalCount == functions.size());
+    CHECK(PciWireValidate(probe.data(), sizeof(PCI_WIRE_HEADER)) == PCI_WIRE_OK);
+    CHECK(PciWireBufferSize(header->TotalCount, header->ConfigSize) == PciWireBufferSize(3, PCI_CFG_SPACE_SIZE));
+}
+
+//  :   ,  ,   ,
+//        
+static void TestTruncation() {
+    std::vector<PCI_WALK_FUNCTION> functions = MakeFunctions();
+    uint32_t size = PciWireBufferSize(2, PCI_CFG_SPACE_SIZE) - 1;
+    std::vector<uint8_t> buffer = Encode(functions, PCI_CFG_SPACE_SIZE, size);
+    const PCI_WIRE_HEADER* header = reinterpret_cast<const PCI_WIRE_HEADER*>(buffer.data());
+
+    CHECK(header->RecordCount == 1);
+    CHECK(header->TotalCount == functions.size());
+    CHECK(header->RecordCount < header->TotalCount);
+    CHECK(PciWireUsedSize(buffer.data()) == PciWireBufferSize(1, PCI_CFG_SPACE_SIZE));
+    CHECK(PciWireValidate(buffer.data(), PciWireUsedSize(buffer.data())) == PCI_WIRE_OK);
+
+    PCI_DEVICE_INFO device;
+    PCI_Config_Decoder::DecodeWireRecord(*PciWireRecordAt(buffer.data(), 0), device);
+    CheckDevice(device, functions[0]);
+
+    // ,   ,   
+    CHECK(PciWireValidate(buffer.data(), PciWireUsedSize(buffer.data()) - 1) == PCI_WIRE_TRUNCATED);
+    CHECK(PciWireValidate(buffer.data(), sizeof(PCI_WIRE_HEADER) - 1) == PCI_WIRE_TRUNCATED);
+}
+
+static void TestBadHeader() {
+    std::vector<PCI_WALK_FUNCTION> functions = MakeFunctions();
+    uint32_t size = PciWireBufferSize(static_cast<uint32_t>(functions.size()), 0);
+    std::vector<uint8_t> good = Encode(functions, 0, size);
+
+    std::vector<uint8_t> buffer = good;
+    reinterpret_cast<PCI_WIRE_HEADER*>(buffer.data())->Magic ^= 1;
+    CHECK(PciWireValidate(buffer.data(), size) == PCI_WIRE_BAD_MAGIC);
+
+    buffer = good;
+    reinterpret_cast<PCI_WIRE_HEADER*>(buffer.data())->Version = PCI_WIRE_VERSION - 1;
+    CHECK(PciWireValidate(buffer.data(), size) == PCI_WIRE_BAD_VERSION);
+
+    buffer = good;
+    reinterpret_cast<PCI_WIRE_HEADER*>(buffer.data())->RecordSize = sizeof(PCI_WIRE_RECORD) - 1;
+    CHECK(PciWireValidate(buffer.data(), size) == PCI_WIRE_BAD_RECORD_SIZE);
+
+    //       
+    buffer = good;
+    reinterpret_cast<PCI_WIRE_HEADER*>(buffer.data())->ConfigSize = 4;
+    CHECK(PciWireValidate(buffer.data(), size) == PCI_WIRE_BAD_RECORD_SIZE);
+}
+
+int main() {
+    TestBufferSize();
+    TestTruncation();
+    TestBadHeader();
+    TestRoundTrip(0);
+    TestRoundTrip(PCI_CFG_SPACE_SIZE);
+    TestRoundTrip(PCI_CFG_HEADER_SIZE);
+
+    return ReportChecks("pci_wire");
+}
\ No newline at end of file
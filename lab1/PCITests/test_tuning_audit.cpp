@@ -0,0 +1,98 @@
+#include <array>
+#include <vector>
+#include "tuning_audit.h"
+#include "../PCICommon/pci_config.h"
+#include "test_check.h"
+
+using TEST_CONFIG = std::array<uint8_t, PCI_CFG_SPACE_SIZE>;
+
+static void Put16(TEST_CONFIG& config, uint16_t offset, uint16_t value) {
+    config[offset] = static_cast<uint8_t>(value);
+    config[offset + 1] = static_cast<uint8_t>(value >> 8);
+}
+
+static void Put32(TEST_CONFIG& config, uint16_t offset, uint32_t value) {
+    Put16(config, offset, static_cast<uint16_t>(value));
+    Put16(config, offset + 2, static_cast<uint16_t>(value >> 16));
+}
+
+//    PCI Express capability   0x40, ASPM 
+static void FillConfig(TEST_CONFIG& config, const PCI_DEVICE_INFO& device, uint8_t portType, uint8_t payloadSupported, uint16_t deviceControl) {
+    config.fill(0);
+    Put32(config, PCI_CFG_ID, device.Virtual ? 0xFFFFFFFFu : (static_cast<uint32_t>(device.DeviceID) << 16) | device.VendorID);
+    Put16(config, PCI_CFG_STATUS, PCI_STATUS_CAP_LIST);
+    Put32(config, PCI_CFG_CLASS_REV, static_cast<uint32_t>(device.BaseClass) << 24 | device.SubClass << 16);
+    Put32(config, PCI_CFG_HEADER, static_cast<uint32_t>(device.HeaderType) << 16);
+    if (device.HeaderType == PCI_HEADER_TYPE_BRIDGE) {
+        Put32(config, PCI_CFG_BUS_NUMBERS, device.Bus | (device.SecondaryBus << 8) | (device.SubordinateBus << 16));
+    }
+    config[PCI_CFG_CAP_PTR] = 0x40;
+
+    Put16(config, 0x40, PCI_CAP_ID_EXP);
+    Put16(config, 0x40 + PCI_EXP_FLAGS, static_cast<uint16_t>(0x0002 | (portType << 4)));
+    Put32(config, 0x40 + PCI_EXP_DEVCAP, payloadSupported);
+    Put16(config, 0x40 + PCI_EXP_DEVCTL, deviceControl);
+    Put32(config, 0x40 + PCI_EXP_LNKCAP, 0x00000084);
+}
+
+static PCI_DEVICE_INFO MakeDevice(uint8_t bus, uint8_t device, uint8_t function, uint8_t headerType, uint8_t baseClass) {
+    PCI_DEVICE_INFO info{};
+    info.Bus = bus;
+    info.Device = device;
+    info.Function = function;
+    info.HeaderType = headerType;
+    info.VendorID = 0x8086;
+    info.DeviceID = 0x1000;
+    info.BaseClass = baseClass;
+    return info;
+}
+
+int main() {
+    //   00:01.0   1:       VF.  PF MPS 256 ,
+    //   , MRRS 512  Relaxed Ordering;  VF   RsvdP   
+    constexpr uint16_t Tuned = (1 << 5) | (2 << 12) | PCI_EXP_DEVCTL_RELAX_EN;
+    std::vector<PCI_DEVICE_INFO> devices = {
+        MakeDevice(0, 1, 0, PCI_HEADER_TYPE_BRIDGE, 0x06),
+        MakeDevice(1, 0, 0, PCI_HEADER_TYPE_NORMAL, 0x02),
+        MakeDevice(1, 0, 1, PCI_HEADER_TYPE_NORMAL, 0x02),
+    };
+    devices[0].SecondaryBus = 1;
+    devices[0].SubordinateBus = 1;
+    devices[2].Virtual = true;
+    devices[2].PhysicalFunction = 0x0100;
+
+    std::vector<TEST_CONFIG> configs(devices.size());
+    FillConfig(configs[0], devices[0], PCI_EXP_TYPE_ROOT_PORT, 1, Tuned);
+    FillConfig(configs[1], devices[1], PCI_EXP_TYPE_ENDPOINT, 1, Tuned);
+    FillConfig(configs[2], devices[2], PCI_EXP_TYPE_ENDPOINT, 1, 0);
+    for (size_t i = 0; i < devices.size(); ++i) {
+        devices[i].Config = configs[i].data();
+        devices[i].ConfigSize = PCI_CFG_SPACE_SIZE;
+    }
+
+    PCI_Topology topology;
+    topology.Build(devices);
+    PCI_Tuning_Audit audit;
+    audit.Build(devices, topology);
+
+    // Capability  VF ,      PF -  
+    CHECK(audit.GetState(2).Present);
+    CHECK(audit.GetState(2).Tuning.Payload == 0);
+    CHECK(audit.GetEndpointCount() == 1);
+    CHECK(audit.GetFindings().empty());
+
+    //   PF  MPS 128 :    ,   
+    FillConfig(configs[1], devices[1], PCI_EXP_TYPE_ENDPOINT, 1, (2 << 12) | PCI_EXP_DEVCTL_RELAX_EN);
+    audit.Build(devices, topology);
+    CHECK(audit.GetFindings().size() == 1);
+    if (audit.GetFindings().size() == 1) {
+        const PCI_TUNING_FINDING& finding = audit.GetFindings()[0];
+        CHECK(finding.Index == 1);
+        CHECK(finding.Peer == 0);
+        CHECK(finding.Issue == PCI_TUNING_ISSUE::PayloadMismatch);
+        CHECK(finding.Value == 128);
+        CHECK(finding.Limit == 256);
+    }
+
+    return ReportChecks("tuning_audit");
+}
\ No newline at end of file